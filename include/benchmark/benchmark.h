@@ -0,0 +1,49 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+
+/*
+ * ⏱️ On-target cycle counts of the filter and arithmetic code.
+ *
+ * The fixed-point entries have a float twin doing the same operation; this
+ * module is the only place where float is linked in on purpose.
+ *
+ * Each entry runs its body (BENCH_BATCH calls) BENCH_RUNS times and keeps the
+ * fastest run, the one no interrupt landed in; the cost of the empty loop is
+ * subtracted and the result divided by BENCH_BATCH gives CPU cycles per call.
+ * Times come from the profiler's Timer1 (8 cycles per tick). ISR entries run
+ * the handler body on scratch state with interrupts off and also print the
+ * edge rate it sustains, an upper bound: the vector entry and exit come on top.
+ *
+ * One entry is measured per call of `benchmarkStep()`, and only when the
+ * transmit buffer is empty, so neither the UART nor the report disturb it.
+ *
+ * The SPI entries take over the bus: they wait for queued transfers to finish,
+ * then transfer to a dummy device selected on BENCH_SPI_CS_PIN (buildConfig.h),
+ * which is claimed on first use and must not be wired to anything else.
+ */
+
+// Calls of the measured function per run
+constexpr uint8_t BENCH_BATCH = 16;
+
+// Runs per entry: the fastest one is kept
+constexpr uint8_t BENCH_RUNS = 8;
+
+#if FEATURE_BENCHMARK
+
+/**
+ * @brief Measures and prints the next entry.
+ *
+ * @return true after the last entry (the next call starts over).
+ */
+bool benchmarkStep();
+
+#else
+
+inline bool benchmarkStep() { return true; }
+
+#endif // FEATURE_BENCHMARK
+
+#endif // BENCHMARK_H
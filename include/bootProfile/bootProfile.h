@@ -0,0 +1,60 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <Arduino.h>
+
+/*
+ * ⏱️ Boot-phase instrumentation and fast-boot background report.
+ *
+ * setup() marks the end of each phase with `bootMark()`; the timestamps
+ * (micros() since the core started Timer0, bootloader time excluded) are
+ * printed in one line by `showBootTimingMessage()`.
+ *
+ * With `fastBoot` enabled, setup() only brings up the serial port, the pins and
+ * the device registry, so sensors start sampling a few milliseconds after reset.
+ * The banner, the configuration/pool reports and the pin diagnostics are then
+ * produced in the background by the `bootReport` device, one step per poll.
+ */
+
+/**
+ * @brief Boot phases, in the order they are reported.
+ */
+enum BootPhase : uint8_t {
+    BOOT_CONFIG = 0,    // Configuration loaded
+    BOOT_SERIAL,        // Serial port ready
+    BOOT_PINS,          // Main configuration pins initialized
+    BOOT_DEVICES,       // Device registry started: sensors sampling
+    BOOT_BANNER,        // Banner and reports printed
+    BOOT_DIAGNOSTICS,   // Pin diagnostics finished
+    BOOT_PHASE_COUNT
+};
+
+/**
+ * @brief Records the end of a boot phase (micros()).
+ */
+void bootMark(BootPhase phase);
+
+/**
+ * @brief Timestamp of a boot phase in µs, 0 if the phase has not been reached.
+ */
+uint32_t bootPhaseMicros(BootPhase phase);
+
+/**
+ * @brief Short name of a boot phase, for reports.
+ */
+const char* bootPhaseName(BootPhase phase);
+
+/**
+ * @brief Enable predicate of the `bootReport` device: fast boot with report pending.
+ */
+bool bootReportPending();
+
+/**
+ * @brief Poll of the `bootReport` device: prints the next piece of the deferred report.
+ *
+ * Each step waits until the serial transmit buffer is empty, so the time it may
+ * block on Serial is bounded by the size of that single step.
+ */
+void bootReportPoll();
+
+#endif // BOOT_PROFILE_H
@@ -0,0 +1,207 @@
+#ifndef BUILD_CONFIG_H
+#define BUILD_CONFIG_H
+
+/*
+ * ⚙️ Build-time configuration, selected per PlatformIO environment (platformio.ini).
+ *
+ * CONFIG_STATIC = 0 (default): `systemConfiguration` is a mutable global checked at
+ *                  runtime and every subsystem is linked in.
+ * CONFIG_STATIC = 1: `systemConfiguration` is constexpr, built from CONFIG_DEBUG_MODE,
+ *                  CONFIG_PROYECTO_LED, CONFIG_FAST_BOOT and CONFIG_LOW_POWER. Branches on disabled
+ *                  flags fold away and the code behind them is not compiled, so the
+ *                  strings, vtables and ISRs of disabled subsystems are not in the image.
+ *
+ * FEATURE_* flags select the optional driver modules. Each module compiles to
+ * nothing when its flag is 0, which also removes its interrupt vectors.
+ */
+
+#ifndef CONFIG_STATIC
+#define CONFIG_STATIC 0
+#endif
+
+#ifndef CONFIG_DEBUG_MODE
+#define CONFIG_DEBUG_MODE 0
+#endif
+
+#ifndef CONFIG_PROYECTO_LED
+#define CONFIG_PROYECTO_LED 0
+#endif
+
+#ifndef CONFIG_FAST_BOOT
+#define CONFIG_FAST_BOOT 0
+#endif
+
+#ifndef CONFIG_LOW_POWER
+#define CONFIG_LOW_POWER 0
+#endif
+
+// Subsystems controlled by the main configuration
+#if CONFIG_STATIC
+#define FEATURE_DEBUGGER        CONFIG_DEBUG_MODE
+#define FEATURE_PROYECTO_LED    CONFIG_PROYECTO_LED
+#else
+#define FEATURE_DEBUGGER        1
+#define FEATURE_PROYECTO_LED    1
+#endif
+
+// EEPROM-backed configuration with serial patching (runtime configuration only)
+#define FEATURE_CONFIG_STORE    (!CONFIG_STATIC)
+
+// Optional driver modules
+#ifndef FEATURE_LED_MATRIX
+#define FEATURE_LED_MATRIX      1
+#endif
+
+#ifndef FEATURE_WS2812
+#define FEATURE_WS2812          1
+#endif
+
+#ifndef FEATURE_SHIFT_REGISTER_LED
+#define FEATURE_SHIFT_REGISTER_LED 1
+#endif
+
+// Interrupt-driven SPI transfer queue (SPI_STC_vect)
+#ifndef FEATURE_SPI_BUS
+#define FEATURE_SPI_BUS         1
+#endif
+
+#if FEATURE_SHIFT_REGISTER_LED && !FEATURE_SPI_BUS
+#error "FEATURE_SHIFT_REGISTER_LED requires FEATURE_SPI_BUS"
+#endif
+
+// Timer1 execution-time profiler
+#ifndef FEATURE_PROFILER
+#define FEATURE_PROFILER        1
+#endif
+
+// Stack/heap high-water monitor (SRAM canary)
+#ifndef FEATURE_MEMORY_MONITOR
+#define FEATURE_MEMORY_MONITOR  1
+#endif
+
+// 32-bit Timer5 timebase with ICP5 input capture
+#ifndef FEATURE_TIMEBASE
+#define FEATURE_TIMEBASE        1
+#endif
+
+// Background 1-Wire master on ICP5 (TIMER5_COMPA_vect)
+#ifndef FEATURE_ONE_WIRE
+#define FEATURE_ONE_WIRE        FEATURE_TIMEBASE
+#endif
+
+#if FEATURE_ONE_WIRE && !FEATURE_TIMEBASE
+#error "FEATURE_ONE_WIRE requires FEATURE_TIMEBASE"
+#endif
+
+// DHT11/DHT22 decoded from ICP5 edge captures
+#ifndef FEATURE_DHT
+#define FEATURE_DHT             FEATURE_TIMEBASE
+#endif
+
+#if FEATURE_DHT && !FEATURE_TIMEBASE
+#error "FEATURE_DHT requires FEATURE_TIMEBASE"
+#endif
+
+// HC-SR04 echo timing; owns the INTn vectors of ULTRASONIC_INT_LINES (bit n = INTn)
+#ifndef FEATURE_ULTRASONIC
+#define FEATURE_ULTRASONIC      FEATURE_TIMEBASE
+#endif
+
+#ifndef ULTRASONIC_INT_LINES
+#define ULTRASONIC_INT_LINES    0x08    // INT3: pin 18
+#endif
+
+#if FEATURE_ULTRASONIC && !FEATURE_TIMEBASE
+#error "FEATURE_ULTRASONIC requires FEATURE_TIMEBASE"
+#endif
+
+// Quadrature encoders and pulse counters; own the INTn vectors of their lines
+#ifndef FEATURE_ENCODER
+#define FEATURE_ENCODER         1
+#endif
+
+#ifndef ENCODER_INT_LINES
+#define ENCODER_INT_LINES       0x30    // Encoder 2: INT4/INT5, pins 2 and 3
+#endif
+
+#ifndef COUNTER_INT_LINES
+#define COUNTER_INT_LINES       0x04    // INT2: pin 19
+#endif
+
+#if (ENCODER_INT_LINES & 0x15) != ((ENCODER_INT_LINES >> 1) & 0x15) || (ENCODER_INT_LINES & ~0x3F)
+#error "ENCODER_INT_LINES must hold whole pairs INT0/1, INT2/3, INT4/5"
+#endif
+
+#if FEATURE_ENCODER && (ENCODER_INT_LINES & COUNTER_INT_LINES)
+#error "ENCODER_INT_LINES and COUNTER_INT_LINES overlap"
+#endif
+
+#if FEATURE_ENCODER && FEATURE_ULTRASONIC && ((ENCODER_INT_LINES | COUNTER_INT_LINES) & ULTRASONIC_INT_LINES)
+#error "ULTRASONIC_INT_LINES overlaps the encoder or counter lines"
+#endif
+
+// Interrupt-driven I2C master (TWI_vect)
+#ifndef FEATURE_TWI
+#define FEATURE_TWI             1
+#endif
+
+// INTn lines claimed by the drivers above
+#define CLAIMED_INT_LINES       ((FEATURE_ULTRASONIC ? ULTRASONIC_INT_LINES : 0) | \
+                                 (FEATURE_ENCODER ? (ENCODER_INT_LINES | COUNTER_INT_LINES) : 0))
+
+// avr8-stub defines ISR(INT0_vect) for single stepping (AVR8_SWINT_SOURCE 0)
+#if FEATURE_DEBUGGER && (CLAIMED_INT_LINES & 0x01)
+#error "INT0 belongs to the debugger: remove it from ULTRASONIC/ENCODER/COUNTER_INT_LINES"
+#endif
+
+// INT0/INT1 share pins 21/20 with SCL/SDA
+#if FEATURE_TWI && (CLAIMED_INT_LINES & 0x03)
+#error "INT0/INT1 are the TWI pins: remove them from ULTRASONIC/ENCODER/COUNTER_INT_LINES"
+#endif
+
+// On-target cycle counts ('bench' command); measured with the profiler's Timer1
+#ifndef FEATURE_BENCHMARK
+#define FEATURE_BENCHMARK       FEATURE_PROFILER
+#endif
+
+#if FEATURE_BENCHMARK && !FEATURE_PROFILER
+#error "FEATURE_BENCHMARK requires FEATURE_PROFILER"
+#endif
+
+// Chip select of the dummy device the SPI entries of 'bench' transfer to
+#ifndef BENCH_SPI_CS_PIN
+#define BENCH_SPI_CS_PIN        49
+#endif
+
+#if FEATURE_BENCHMARK && FEATURE_SPI_BUS
+
+#if BENCH_SPI_CS_PIN <= 1 || (BENCH_SPI_CS_PIN >= 50 && BENCH_SPI_CS_PIN <= 53) || BENCH_SPI_CS_PIN > 69
+#error "BENCH_SPI_CS_PIN must not be a Serial or SPI pin"
+#endif
+
+// ICP5, owned by the timebase (TIMEBASE_CAPTURE_PIN) and the 1-Wire master
+#if FEATURE_TIMEBASE && BENCH_SPI_CS_PIN == 48
+#error "BENCH_SPI_CS_PIN is the timebase capture pin"
+#endif
+
+// UART3 (pins 14/15) carries avr8-stub
+#if FEATURE_DEBUGGER && (BENCH_SPI_CS_PIN == 14 || BENCH_SPI_CS_PIN == 15)
+#error "BENCH_SPI_CS_PIN is a debugger UART pin"
+#endif
+
+#if FEATURE_TWI && (BENCH_SPI_CS_PIN == 20 || BENCH_SPI_CS_PIN == 21)
+#error "BENCH_SPI_CS_PIN is a TWI pin"
+#endif
+
+// INTn line of the pin, if any (INT0..INT5: pins 21, 20, 19, 18, 2, 3)
+#define BENCH_SPI_CS_INT_LINE   ((BENCH_SPI_CS_PIN == 21) ? 0x01 : (BENCH_SPI_CS_PIN == 20) ? 0x02 : \
+                                 (BENCH_SPI_CS_PIN == 19) ? 0x04 : (BENCH_SPI_CS_PIN == 18) ? 0x08 : \
+                                 (BENCH_SPI_CS_PIN == 2)  ? 0x10 : (BENCH_SPI_CS_PIN == 3)  ? 0x20 : 0)
+
+#if CLAIMED_INT_LINES & BENCH_SPI_CS_INT_LINE
+#error "BENCH_SPI_CS_PIN is an external interrupt line of ULTRASONIC/ENCODER/COUNTER_INT_LINES"
+#endif
+
+#endif // FEATURE_BENCHMARK && FEATURE_SPI_BUS
+
+#endif // BUILD_CONFIG_H
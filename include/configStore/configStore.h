@@ -0,0 +1,68 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+#include "configuracion.h"
+
+/*
+ * 💾 EEPROM-backed runtime configuration.
+ *
+ * `systemConfiguration` is stored in EEPROM as a versioned blob:
+ *
+ *   [version][length][configuracionMain ...][crc16]
+ *
+ * The blob is checked at boot (version, length and CRC-16); if any of them does
+ * not match, the compiled-in `defaultConfiguration` is used and written back.
+ *
+ * The `cfg` shell command (shell.h) patches fields over serial through
+ * `configCommand()`. `debugMode` applies to the next boot only: setup() does
+ * not start Serial in debug mode (avr8-stub talks over UART3), so the shell
+ * is unavailable to turn it off. loadConfiguration() therefore schedules the
+ * stored flag to be cleared as soon as it reads it, and the boot after returns
+ * to the console.
+ *
+ * Saving is incremental: only bytes that differ from the EEPROM are written, one
+ * per call to `configStorePoll()` once the EEPROM is ready, so neither write
+ * cycles nor loop() time are spent on unchanged data.
+ */
+
+// EEPROM address of the configuration blob
+constexpr uint16_t CONFIG_EEPROM_ADDRESS = 0;
+// Layout version: increase it when configuracionMain changes
+constexpr uint8_t CONFIG_BLOB_VERSION = 3;
+
+/**
+ * @brief Loads `systemConfiguration` from EEPROM.
+ *
+ * @return true if a valid blob was found; false if the defaults were used
+ *         (they are scheduled to be written back).
+ * @pre Call at the very beginning of setup(), before the configuration is used.
+ */
+bool loadConfiguration();
+
+/**
+ * @brief Schedules the current `systemConfiguration` to be written to EEPROM.
+ *
+ * The write itself is done by `configStorePoll()`, one changed byte at a time.
+ */
+void saveConfiguration();
+
+/**
+ * @brief Non-blocking service routine: advances the pending EEPROM write.
+ *
+ * Registered as a device polled every 20 ms.
+ */
+void configStorePoll();
+
+/**
+ * @brief Executes one `cfg` command (shell handler).
+ *
+ * The shell prints the configuration afterwards, one piece per poll.
+ *
+ * @param args  Text after the `cfg` keyword (may be empty).
+ * @return true if the configuration is to be shown (no arguments or a field
+ *         changed); false after an error.
+ */
+bool configCommand(const char* args);
+
+#endif // CONFIG_STORE_H
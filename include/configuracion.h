@@ -1,6 +1,7 @@
 #ifndef     CONF_MAIN_H
 #define     CONF_MAIN_H
 
+#include "buildConfig.h"
 #include "sensors_Led/sensor_Led.h"
 
 /**
@@ -13,8 +14,24 @@
 struct configuracionMain {
     bool debugMode;
     bool proyectoLed;
+    bool fastBoot;      // Start sensors first, banner and diagnostics in the background
+    bool lowPower;      // Console may sleep: the first character only wakes the board
 };
+
+#if CONFIG_STATIC
+// Build-time configuration: every check on it is folded by the compiler
+constexpr configuracionMain systemConfiguration = {
+    .debugMode = CONFIG_DEBUG_MODE,
+    .proyectoLed = CONFIG_PROYECTO_LED,
+    .fastBoot = CONFIG_FAST_BOOT,
+    .lowPower = CONFIG_LOW_POWER
+};
+#else
+// Runtime configuration (loaded from EEPROM at boot, see configStore.h)
 extern configuracionMain systemConfiguration;
+// Compiled-in values, used when EEPROM holds no valid configuration
+extern const configuracionMain defaultConfiguration;
+#endif
 
 /**
  * @brief Initializes hardware pins according to the provided configuration.
@@ -22,6 +39,7 @@ extern configuracionMain systemConfiguration;
  * Sets directions, initial states, and internal resistors for the pins
  * required by the project. If `debugMode` is active, enables pins for
  * diagnostics/tracing; if `proyectoLed` is active, prepares pins for the LED subsystem.
+ * Calling it again after a runtime change releases the subsystems that were disabled.
  *
  * @param configuration  Structure with flags that determine which pins are configured.
  * @pre Call once during system startup, before using peripherals.
@@ -30,6 +48,10 @@ extern configuracionMain systemConfiguration;
 void initializeMainConfigurationPins(configuracionMain systemConfiguration);
 
 // List of pins
+#if FEATURE_PROYECTO_LED
 extern LedRojo* ledRojo;
+#else
+constexpr LedRojo* ledRojo = nullptr;
+#endif
 
 #endif // CONF_MAIN_H
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <Arduino.h>
+#include "scheduler/scheduler.h"
+
+/*
+ * 🔁 Stackless coroutines (protothread style) for multi-step driver sequences.
+ *
+ * A coroutine is a plain `void` function whose body sits between CORO_BEGIN
+ * and CORO_END; its only state is a `Coroutine` (4 bytes) holding the resume
+ * point and the start of the current delay. A wait stores the resume point and
+ * returns to the scheduler; the next call jumps straight back to it.
+ *
+ *   static Coroutine reading;
+ *   static void readingTask() {
+ *       CORO_BEGIN(reading);
+ *       triggerConversion();
+ *       CORO_DELAY(reading, 750);               // The task sleeps 750 ms
+ *       CORO_WAIT_UNTIL(reading, dataReady());  // Polled every period
+ *       publishSample();
+ *       CORO_END(reading);
+ *   }
+ *
+ * When the coroutine is the body of a scheduler task, CORO_DELAY defers the
+ * task (schedulerDefer) so it is not called again until the delay expires.
+ *
+ * Rules (the body is a switch on the resume point):
+ *  - local variables do not survive a wait: keep them static or in a struct;
+ *  - no `switch` statement may contain a wait;
+ *  - at most one wait per source line.
+ */
+
+// Resume point of a coroutine that reached CORO_END
+constexpr uint16_t CORO_FINISHED = 0xFFFF;
+
+/**
+ * @brief State of one coroutine.
+ */
+struct Coroutine {
+    uint16_t line;   // Resume point: 0 = start, CORO_FINISHED = ended
+    uint16_t mark;   // Start of the current delay (low 16 bits of schedulerMillis)
+
+    bool done() const { return line == CORO_FINISHED; }
+    void reset() { line = 0; }
+};
+
+#define CORO_BEGIN(co)                  \
+    switch ((co).line) {                \
+    case 0:
+
+// Returns now and resumes after this point on the next call
+#define CORO_YIELD(co)                  \
+    do {                                \
+        (co).line = __LINE__;           \
+        return;                         \
+    case __LINE__:;                     \
+    } while (0)
+
+// Returns until `condition` is true (evaluated on every call)
+#define CORO_WAIT_UNTIL(co, condition)  \
+    do {                                \
+        (co).line = __LINE__;           \
+    case __LINE__:                      \
+        if (!(condition)) {             \
+            return;                     \
+        }                               \
+    } while (0)
+
+// Waits `ms` milliseconds (up to 65535) without blocking
+#define CORO_DELAY(co, ms)                                                          \
+    do {                                                                            \
+        (co).mark = (uint16_t)schedulerMillis();                                    \
+        (co).line = __LINE__;                                                       \
+        schedulerDefer(ms);                                                         \
+        return;                                                                     \
+    case __LINE__:                                                                  \
+        const uint16_t coroElapsed = (uint16_t)schedulerMillis() - (co).mark;       \
+        if (coroElapsed < (uint16_t)(ms)) {                                         \
+            schedulerDefer((uint16_t)(ms) - coroElapsed);                           \
+            return;                                                                 \
+        }                                                                           \
+    } while (0)
+
+// Starts the coroutine again from CORO_BEGIN on the next call
+#define CORO_RESTART(co)                \
+    do {                                \
+        (co).line = 0;                  \
+        return;                         \
+    } while (0)
+
+#define CORO_END(co)                    \
+    }                                   \
+    (co).line = CORO_FINISHED;          \
+    return
+
+#endif // COROUTINE_H
@@ -0,0 +1,161 @@
+#ifndef DATA_BUS_H
+#define DATA_BUS_H
+
+#include <Arduino.h>
+#include "dataBus/topics.h"
+
+/*
+ * 📡 Publish/subscribe bus for sensor data.
+ *
+ * Every topic (topics.h) has one statically allocated slot holding its latest
+ * sample and a sequence number. A publisher writes the sample once, in place
+ * (`busSlot()` + `busCommit()`) or by value (`busPublish()`); then:
+ *  - callbacks registered with `busSubscribe()` receive a const reference to
+ *    the slot, called in the publisher's context (keep them short);
+ *  - pollers keep a `BusReader` and read the slot only when its sequence
+ *    number changed.
+ * Samples are never copied by the bus and nothing is allocated.
+ *
+ * Publish from tasks only; data produced in an ISR goes through an SpscQueue
+ * to the task that publishes it.
+ */
+
+/**
+ * @brief Compile-time topic identifiers, from DATABUS_TOPICS.
+ */
+enum TopicId : uint8_t {
+#define DATABUS_TOPIC_ID(id, type, name) id,
+    DATABUS_TOPICS(DATABUS_TOPIC_ID)
+#undef DATABUS_TOPIC_ID
+    TOPIC_COUNT
+};
+
+/**
+ * @brief Sample type of each topic.
+ */
+template <TopicId ID>
+struct TopicTraits;
+
+#define DATABUS_TOPIC_TRAITS(id, type, name) \
+    template <> struct TopicTraits<id> { typedef type Type; };
+DATABUS_TOPICS(DATABUS_TOPIC_TRAITS)
+#undef DATABUS_TOPIC_TRAITS
+
+// Size of the subscription table
+constexpr uint8_t MAX_SUBSCRIBERS = 16;
+
+// Stored callback; cast back to its real type before the call
+typedef void (*BusHook)();
+// Calls a stored callback with a sample of the topic type
+typedef void (*BusInvoker)(BusHook hook, const void* sample);
+
+// Untyped part, implemented in dataBus.cpp (use the typed templates below)
+bool busAddSubscriber(TopicId topic, BusHook hook);
+void busRemoveSubscriber(TopicId topic, BusHook hook);
+void busNotify(TopicId topic, BusInvoker invoker, const void* sample);
+
+/**
+ * @brief Number of samples published on `topic` since boot (wraps at 65536).
+ */
+uint16_t busSequence(TopicId topic);
+
+/**
+ * @brief Callbacks registered on `topic`.
+ */
+uint8_t busSubscriberCount(TopicId topic);
+
+/**
+ * @brief Name of `topic` (PROGMEM string).
+ */
+const char* busTopicName(TopicId topic);
+
+/**
+ * @brief Storage of one topic: the latest sample.
+ */
+template <TopicId ID>
+struct TopicSlot {
+    static typename TopicTraits<ID>::Type value;
+
+    static void invoke(BusHook hook, const void* sample) {
+        typedef void (*Callback)(const typename TopicTraits<ID>::Type&);
+        ((Callback)hook)(*(const typename TopicTraits<ID>::Type*)sample);
+    }
+};
+
+template <TopicId ID>
+typename TopicTraits<ID>::Type TopicSlot<ID>::value;
+
+/**
+ * @brief Slot of a topic, to write a sample in place before `busCommit()`.
+ */
+template <TopicId ID>
+inline typename TopicTraits<ID>::Type& busSlot() {
+    return TopicSlot<ID>::value;
+}
+
+/**
+ * @brief Publishes the sample written in the slot: bumps the sequence and calls the subscribers.
+ */
+template <TopicId ID>
+inline void busCommit() {
+    busNotify(ID, TopicSlot<ID>::invoke, &TopicSlot<ID>::value);
+}
+
+/**
+ * @brief Writes a sample into the slot and publishes it.
+ */
+template <TopicId ID>
+inline void busPublish(const typename TopicTraits<ID>::Type& sample) {
+    TopicSlot<ID>::value = sample;
+    busCommit<ID>();
+}
+
+/**
+ * @brief Registers a callback for every sample of topic ID.
+ *
+ * @return false if the subscription table is full.
+ */
+template <TopicId ID>
+inline bool busSubscribe(void (*callback)(const typename TopicTraits<ID>::Type&)) {
+    return busAddSubscriber(ID, (BusHook)callback);
+}
+
+/**
+ * @brief Removes a callback registered with `busSubscribe()`.
+ */
+template <TopicId ID>
+inline void busUnsubscribe(void (*callback)(const typename TopicTraits<ID>::Type&)) {
+    busRemoveSubscriber(ID, (BusHook)callback);
+}
+
+/**
+ * @brief Polling subscriber: remembers the last sequence number it read.
+ */
+template <TopicId ID>
+class BusReader {
+public:
+    BusReader() : seen(busSequence(ID)) {}
+
+    /**
+     * @brief True if a sample was published since the last `read()`.
+     */
+    bool changed() const { return busSequence(ID) != seen; }
+
+    /**
+     * @brief Samples published since the last `read()` (more than 1: some were skipped).
+     */
+    uint16_t pending() const { return busSequence(ID) - seen; }
+
+    /**
+     * @brief Latest sample, by reference to the slot; marks it as read.
+     */
+    const typename TopicTraits<ID>::Type& read() {
+        seen = busSequence(ID);
+        return TopicSlot<ID>::value;
+    }
+
+private:
+    uint16_t seen;
+};
+
+#endif // DATA_BUS_H
@@ -0,0 +1,17 @@
+#ifndef TOPICS_H
+#define TOPICS_H
+
+#include <Arduino.h>
+
+/*
+ * 📡 Topics of the data bus: one row per kind of sample in the project.
+ *
+ * X(id, type, name): `id` becomes a TopicId constant, `type` the sample stored
+ * in its slot and `name` the label in the `bus` report.
+ *
+ * Adding a sensor topic: add a row here, publish it from the sensor task.
+ */
+#define DATABUS_TOPICS(X) \
+    X(TOPIC_LED_ROJO, bool, "ledRojo")
+
+#endif // TOPICS_H
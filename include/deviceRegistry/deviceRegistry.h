@@ -0,0 +1,57 @@
+#ifndef DEVICE_REGISTRY_H
+#define DEVICE_REGISTRY_H
+
+#include <Arduino.h>
+#include "scheduler/scheduler.h"
+
+/*
+ * 🗂️ Device registry: every sensor, actuator or service of the project is one
+ * row of `deviceTable` (configuracion.cpp), stored in flash and built at compile
+ * time. Every enabled row becomes a periodic task of the scheduler, which
+ * dispatches and times it; disabled rows cost nothing at run time.
+ *
+ * Adding a sensor: write its init/poll functions, add a row to `deviceTable`.
+ */
+
+typedef bool (*DevicePredicate)();
+typedef void (*DeviceHook)();
+
+/**
+ * @brief Descriptor of one registered device (lives in PROGMEM).
+ */
+struct DeviceDescriptor {
+    const char* name;        // Name in flash (PROGMEM string)
+    DevicePredicate enabled; // Enable predicate, nullptr = always enabled
+    DeviceHook init;         // Called when the device becomes enabled, may be nullptr
+    DeviceHook poll;         // Called every periodMs while enabled
+    uint16_t periodMs;       // 0 = on every scheduler tick
+    TaskPriority priority;   // Priority of the poll task
+};
+
+// Maximum number of rows in deviceTable
+constexpr uint8_t MAX_DEVICES = 16;
+
+// Provided by the project (configuracion.cpp)
+extern const DeviceDescriptor deviceTable[] PROGMEM;
+extern const uint8_t deviceCount;
+
+/**
+ * @brief Evaluates the enable predicates, initializes newly enabled devices and
+ *        adds/removes their poll tasks.
+ *
+ * Call from setup() after `schedulerBegin()`, and again whenever the
+ * configuration changes at runtime.
+ */
+void deviceRegistryBegin();
+
+/**
+ * @brief Returns true if device `id` is currently enabled.
+ */
+bool deviceEnabled(uint8_t id);
+
+/**
+ * @brief Scheduler task of device `id`, INVALID_TASK if it is disabled.
+ */
+uint8_t deviceTaskId(uint8_t id);
+
+#endif // DEVICE_REGISTRY_H
@@ -0,0 +1,300 @@
+#ifndef FILTERS_H
+#define FILTERS_H
+
+#include <stdint.h>
+
+/*
+ * 📈 Fixed-point filters for sensor streams (header only, no float).
+ *
+ *   MovingAverage<T, N>  → mean of the last N samples, O(1) running sum
+ *   MedianFilter<T, N>   → median of the last N (3, 5, 7 or 9), selection network
+ *   ExpFilter<T, SHIFT>  → first-order IIR (EMA), alpha = 1 / 2^SHIFT
+ *   BiquadQ15<SHIFT>     → second-order IIR, Q15 samples and coefficients
+ *
+ * All state is inside the object; the first sample primes the window (no
+ * ramp-up from zero). Cycle counts on target: `bench` shell command.
+ */
+
+/**
+ * @brief Accumulator wide enough for sums and scaled values of T.
+ */
+template <typename T> struct FilterWide;
+template <> struct FilterWide<int8_t> { typedef int16_t Type; };
+template <> struct FilterWide<uint8_t> { typedef uint16_t Type; };
+template <> struct FilterWide<int16_t> { typedef int32_t Type; };
+template <> struct FilterWide<uint16_t> { typedef uint32_t Type; };
+template <> struct FilterWide<int32_t> { typedef int64_t Type; };
+template <> struct FilterWide<uint32_t> { typedef uint64_t Type; };
+
+/**
+ * @brief Mean of the last N samples.
+ *
+ * The sum is updated with the incoming and outgoing sample only, so the cost
+ * does not depend on N; a power-of-two N turns the division into shifts.
+ *
+ * @tparam T    Sample type.
+ * @tparam N    Window length, 2..255.
+ * @tparam Acc  Running sum (N * max(T) must fit).
+ */
+template <typename T, uint8_t N, typename Acc = typename FilterWide<T>::Type>
+class MovingAverage {
+    static_assert(N >= 2, "Moving average window must hold at least 2 samples");
+
+public:
+    MovingAverage() : window(), sum(0), index(0), primed(false) {}
+
+    /**
+     * @brief Fills the whole window with `sample`.
+     */
+    void reset(T sample) {
+        for (uint8_t i = 0; i < N; ++i) {
+            window[i] = sample;
+        }
+        sum = (Acc)sample * N;
+        index = 0;
+        primed = true;
+    }
+
+    /**
+     * @brief Adds a sample and returns the new mean.
+     */
+    T update(T sample) {
+        if (!primed) {
+            reset(sample);
+        }
+        sum += (Acc)sample - (Acc)window[index];
+        window[index] = sample;
+        if (++index == N) {
+            index = 0;
+        }
+        return value();
+    }
+
+    T value() const { return (T)(sum / (Acc)N); }
+
+private:
+    T window[N];
+    Acc sum;
+    uint8_t index;
+    bool primed;
+};
+
+/**
+ * @brief Compare-exchange: `a` keeps the smaller value.
+ */
+template <typename T>
+inline void filterOrder(T& a, T& b) {
+    if (b < a) {
+        const T t = a;
+        a = b;
+        b = t;
+    }
+}
+
+/**
+ * @brief Median selection networks: the minimum comparator sets that leave
+ *        the median in the middle element (Paeth/Devillard).
+ */
+template <uint8_t N> struct MedianNetwork;
+
+template <> struct MedianNetwork<3> {
+    template <typename T> static T select(T* p) {
+        filterOrder(p[0], p[1]); filterOrder(p[1], p[2]); filterOrder(p[0], p[1]);
+        return p[1];
+    }
+};
+
+template <> struct MedianNetwork<5> {
+    template <typename T> static T select(T* p) {
+        filterOrder(p[0], p[1]); filterOrder(p[3], p[4]); filterOrder(p[0], p[3]);
+        filterOrder(p[1], p[4]); filterOrder(p[1], p[2]); filterOrder(p[2], p[3]);
+        filterOrder(p[1], p[2]);
+        return p[2];
+    }
+};
+
+template <> struct MedianNetwork<7> {
+    template <typename T> static T select(T* p) {
+        filterOrder(p[0], p[5]); filterOrder(p[0], p[3]); filterOrder(p[1], p[6]);
+        filterOrder(p[2], p[4]); filterOrder(p[0], p[1]); filterOrder(p[3], p[5]);
+        filterOrder(p[2], p[6]); filterOrder(p[2], p[3]); filterOrder(p[3], p[6]);
+        filterOrder(p[4], p[5]); filterOrder(p[1], p[4]); filterOrder(p[1], p[3]);
+        filterOrder(p[3], p[4]);
+        return p[3];
+    }
+};
+
+template <> struct MedianNetwork<9> {
+    template <typename T> static T select(T* p) {
+        filterOrder(p[1], p[2]); filterOrder(p[4], p[5]); filterOrder(p[7], p[8]);
+        filterOrder(p[0], p[1]); filterOrder(p[3], p[4]); filterOrder(p[6], p[7]);
+        filterOrder(p[1], p[2]); filterOrder(p[4], p[5]); filterOrder(p[7], p[8]);
+        filterOrder(p[0], p[3]); filterOrder(p[5], p[8]); filterOrder(p[4], p[7]);
+        filterOrder(p[3], p[6]); filterOrder(p[1], p[4]); filterOrder(p[2], p[5]);
+        filterOrder(p[4], p[7]); filterOrder(p[4], p[2]); filterOrder(p[6], p[4]);
+        filterOrder(p[4], p[2]);
+        return p[4];
+    }
+};
+
+/**
+ * @brief Median of the last N samples: rejects spikes shorter than N/2 samples.
+ *
+ * @tparam T  Sample type.
+ * @tparam N  Window length: 3, 5, 7 or 9.
+ */
+template <typename T, uint8_t N>
+class MedianFilter {
+    static_assert(N == 3 || N == 5 || N == 7 || N == 9, "Median window must be 3, 5, 7 or 9");
+
+public:
+    MedianFilter() : window(), index(0), primed(false) {}
+
+    /**
+     * @brief Fills the whole window with `sample`.
+     */
+    void reset(T sample) {
+        for (uint8_t i = 0; i < N; ++i) {
+            window[i] = sample;
+        }
+        index = 0;
+        primed = true;
+    }
+
+    /**
+     * @brief Adds a sample and returns the median of the window.
+     */
+    T update(T sample) {
+        if (!primed) {
+            reset(sample);
+        }
+        window[index] = sample;
+        if (++index == N) {
+            index = 0;
+        }
+        T scratch[N];
+        for (uint8_t i = 0; i < N; ++i) {
+            scratch[i] = window[i];
+        }
+        return MedianNetwork<N>::select(scratch);
+    }
+
+private:
+    T window[N];
+    uint8_t index;
+    bool primed;
+};
+
+/**
+ * @brief First-order IIR (exponential moving average): y += (x - y) / 2^SHIFT.
+ *
+ * The state keeps SHIFT extra fraction bits, so small steps are not lost to
+ * truncation; the time constant is about 2^SHIFT samples.
+ *
+ * @tparam T      Sample type.
+ * @tparam SHIFT  Smoothing, 1..(bits of Acc - bits of T - 1).
+ * @tparam Acc    Scaled state.
+ */
+template <typename T, uint8_t SHIFT, typename Acc = typename FilterWide<T>::Type>
+class ExpFilter {
+    static_assert(SHIFT >= 1 && SHIFT < 8 * (sizeof(Acc) - sizeof(T)), "EMA shift does not fit the accumulator");
+
+public:
+    ExpFilter() : state(0), primed(false) {}
+
+    /**
+     * @brief Sets the output to `sample`.
+     */
+    void reset(T sample) {
+        state = (Acc)sample * ((Acc)1 << SHIFT);
+        primed = true;
+    }
+
+    /**
+     * @brief Adds a sample and returns the new output.
+     */
+    T update(T sample) {
+        if (!primed) {
+            reset(sample);
+        }
+        state += (Acc)sample - (state >> SHIFT);
+        return value();
+    }
+
+    T value() const { return (T)(state >> SHIFT); }
+
+private:
+    Acc state;
+    bool primed;
+};
+
+/**
+ * @brief Biquad coefficients, Q15, already divided by 2^POST_SHIFT.
+ *
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]  (a0 = 1)
+ */
+struct BiquadCoefficients {
+    int16_t b0, b1, b2, a1, a2;
+};
+
+/**
+ * @brief Converts a real coefficient to Q15 / 2^postShift at compile time.
+ */
+constexpr int16_t biquadQ15(double value, uint8_t postShift) {
+    return (int16_t)(value * (32768.0 / (1 << postShift)) + (value < 0 ? -0.5 : 0.5));
+}
+
+/**
+ * @brief Coefficients from the real values (use in a constexpr context: no float at run time).
+ */
+constexpr BiquadCoefficients biquadCoefficients(double b0, double b1, double b2,
+                                                double a1, double a2, uint8_t postShift) {
+    return BiquadCoefficients{biquadQ15(b0, postShift), biquadQ15(b1, postShift), biquadQ15(b2, postShift),
+                              biquadQ15(a1, postShift), biquadQ15(a2, postShift)};
+}
+
+/**
+ * @brief Second-order IIR section, direct form I, Q15 samples.
+ *
+ * Coefficients are stored divided by 2^POST_SHIFT so that |a1| up to 2 fits
+ * in Q15; the 32-bit sum is scaled back by POST_SHIFT and saturated. The
+ * scaled coefficients must add up (in absolute value) to less than 2.
+ *
+ * @tparam POST_SHIFT  Coefficient headroom in bits (1 covers every stable low/high-pass).
+ */
+template <uint8_t POST_SHIFT = 1>
+class BiquadQ15 {
+    static_assert(POST_SHIFT <= 3, "Biquad post shift leaves too few coefficient bits");
+
+public:
+    explicit BiquadQ15(const BiquadCoefficients& coefficients) :
+        c(coefficients), x1(0), x2(0), y1(0), y2(0) {}
+
+    /**
+     * @brief Clears the delay line.
+     */
+    void reset() {
+        x1 = x2 = y1 = y2 = 0;
+    }
+
+    /**
+     * @brief Filters one sample.
+     */
+    int16_t update(int16_t x) {
+        int32_t acc = (int32_t)c.b0 * x + (int32_t)c.b1 * x1 + (int32_t)c.b2 * x2
+                    - (int32_t)c.a1 * y1 - (int32_t)c.a2 * y2;
+        acc = (acc + ((int32_t)1 << (14 - POST_SHIFT))) >> (15 - POST_SHIFT);
+        const int16_t y = acc > INT16_MAX ? INT16_MAX : (acc < INT16_MIN ? INT16_MIN : (int16_t)acc);
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        return y;
+    }
+
+private:
+    BiquadCoefficients c;
+    int16_t x1, x2, y1, y2;
+};
+
+#endif // FILTERS_H
@@ -0,0 +1,228 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+/*
+ * 🔢 Signed fixed-point numbers with saturating arithmetic (header only).
+ *
+ * `Fixed<I, F>` has I integer bits, F fraction bits and a sign bit, stored in
+ * an int16_t (I + F <= 15) or an int32_t (I + F <= 31). Results that do not
+ * fit saturate at the limits instead of wrapping.
+ *
+ *   typedef Fixed<7, 8> Celsius;
+ *   constexpr Celsius offset = Celsius::from(-0.5);   // converted by the compiler
+ *   Celsius t = Celsius::fromRaw(raw) * gain + offset;
+ *
+ * `from(double)` is meant for literals in constexpr contexts: called with a
+ * run-time value it would pull in the soft-float library this type avoids.
+ *
+ * Multiplications and divisions by a constant ratio use a precomputed
+ * reciprocal: `FixedRatio<NUM, DEN>` (common scales below) turns x * NUM / DEN
+ * into two 16x16 multiplies and a shift, with no division at run time.
+ * Plain-C++ header: the native tests (test/test_dsp) sweep it on the host.
+ */
+
+/**
+ * @brief Raw storage and product width of a Fixed format.
+ */
+template <bool FITS_16> struct FixedRaw { typedef int32_t Type; typedef int64_t Wide; };
+template <> struct FixedRaw<true> { typedef int16_t Type; typedef int32_t Wide; };
+
+/**
+ * @brief Smallest shift (>= 16) whose rounded-up multiplier is exact for every 16-bit x.
+ *
+ * With M = ceil(num * 2^shift / den) = (num * 2^shift + e) / den, x * M / 2^shift
+ * exceeds x * num / den by x * e / (den * 2^shift), which stays below 1 / den
+ * (the gap to the next integer quotient) while 0xFFFF * e < 2^shift.
+ */
+constexpr uint8_t fixedRatioShift(uint64_t num, uint64_t den, uint8_t shift) {
+    return (shift < 32 && 0xFFFF * ((den - (((num % den) << shift) % den)) % den) >= ((uint64_t)1 << shift))
+        ? fixedRatioShift(num, den, shift + 1) : shift;
+}
+
+/**
+ * @brief x * NUM / DEN as (x * MULTIPLIER) >> SHIFT, computed at compile time.
+ *
+ * The multiplier is rounded up and has up to 32 bits; fixedRatioApply() splits
+ * it so the product never needs more than 32 bits. The result equals
+ * floor(x * NUM / DEN) for every x in 0..65535.
+ */
+template <uint32_t NUM, uint32_t DEN>
+struct FixedRatio {
+    static_assert(DEN != 0 && DEN <= 0xFFFF, "Ratio denominator must be 1..65535");
+    static_assert(NUM / DEN <= 0xFFFF, "Ratio must be below 65536");
+
+    static constexpr uint8_t SHIFT = fixedRatioShift(NUM, DEN, 16);
+    static constexpr uint64_t WIDE_MULTIPLIER =
+        ((uint64_t)(NUM / DEN) << SHIFT) + ((((uint64_t)(NUM % DEN) << SHIFT) + DEN - 1) / DEN);
+    static_assert(WIDE_MULTIPLIER <= 0xFFFFFFFF, "Ratio needs a multiplier above 32 bits");
+    static constexpr uint32_t MULTIPLIER = (uint32_t)WIDE_MULTIPLIER;
+};
+
+/**
+ * @brief (x * Ratio::MULTIPLIER) >> Ratio::SHIFT with a product no wider than W.
+ *
+ * floor((x * H * 2^16 + x * L) / 2^SHIFT) == floor((x * H + floor(x * L / 2^16)) / 2^(SHIFT - 16)),
+ * so a 16-bit x needs only 32-bit products. Negative x round towards minus infinity.
+ */
+template <typename Ratio, typename W>
+constexpr W fixedRatioApply(W x) {
+    return (x * (W)(Ratio::MULTIPLIER >> 16) + ((x * (W)(Ratio::MULTIPLIER & 0xFFFF)) >> 16)) >> (Ratio::SHIFT - 16);
+}
+
+// Common scales: reciprocals of the usual divisors and the ADC conversions
+typedef FixedRatio<1, 10> RatioDiv10;
+typedef FixedRatio<1, 100> RatioDiv100;
+typedef FixedRatio<1, 1000> RatioDiv1000;
+typedef FixedRatio<1, 60> RatioDiv60;
+typedef FixedRatio<5000, 1023> RatioAdcToMillivolts5V;     // AVcc reference
+typedef FixedRatio<1100, 1023> RatioAdcToMillivolts1V1;    // Internal 1.1 V reference
+typedef FixedRatio<2560, 1023> RatioAdcToMillivolts2V56;   // Internal 2.56 V reference
+typedef FixedRatio<9, 5> RatioCelsiusToFahrenheit;          // Add 32 afterwards
+
+/**
+ * @brief floor(x * NUM / DEN) for a FixedRatio, saturated (no division).
+ */
+template <typename Ratio>
+inline uint16_t fixedScale(uint16_t x) {
+    const uint32_t scaled = fixedRatioApply<Ratio>((uint32_t)x);
+    return scaled > 0xFFFF ? 0xFFFF : (uint16_t)scaled;
+}
+
+/**
+ * @brief Signed fixed-point number.
+ *
+ * @tparam I  Integer bits (without the sign).
+ * @tparam F  Fraction bits: resolution 1 / 2^F.
+ */
+template <uint8_t I, uint8_t F>
+class Fixed {
+    static_assert(I + F <= 31, "Fixed format needs more than 32 bits");
+
+public:
+    typedef typename FixedRaw<I + F <= 15>::Type Raw;
+    typedef typename FixedRaw<I + F <= 15>::Wide Wide;
+
+    static constexpr uint8_t INT_BITS = I;
+    static constexpr uint8_t FRAC_BITS = F;
+    static constexpr Raw RAW_MAX = (Raw)(((Wide)1 << (I + F)) - 1);
+    static constexpr Raw RAW_MIN = (Raw)(-RAW_MAX - 1);
+
+    constexpr Fixed() : value(0) {}
+
+    static constexpr Fixed fromRaw(Raw raw) { return Fixed(raw, 0); }
+
+    /**
+     * @brief Integer value, saturated.
+     */
+    static constexpr Fixed fromInt(int32_t n) {
+        return fromRaw(n > (RAW_MAX >> F) ? RAW_MAX : (n < (RAW_MIN >> F) ? RAW_MIN : (Raw)(n * ((Wide)1 << F))));
+    }
+
+    /**
+     * @brief Real literal, rounded and saturated (constexpr contexts only, see above).
+     */
+    static constexpr Fixed from(double x) {
+        return fromRaw(x * ONE >= RAW_MAX ? RAW_MAX
+                     : (x * ONE <= RAW_MIN ? RAW_MIN
+                     : (Raw)(x * ONE + (x < 0 ? -0.5 : 0.5))));
+    }
+
+    static constexpr Fixed maxValue() { return fromRaw(RAW_MAX); }
+    static constexpr Fixed minValue() { return fromRaw(RAW_MIN); }
+
+    constexpr Raw raw() const { return value; }
+
+    /**
+     * @brief Integer part, rounded towards minus infinity.
+     */
+    constexpr int32_t toInt() const { return value >> F; }
+
+    /**
+     * @brief Nearest integer (halves away from minus infinity).
+     */
+    constexpr int32_t roundToInt() const { return ((Wide)value + HALF) >> F; }
+
+    /**
+     * @brief Float value, for printing only (links the soft-float library).
+     */
+    float toFloat() const { return (float)value / ONE; }
+
+    /**
+     * @brief Same value in another format, saturated if it does not fit.
+     */
+    template <uint8_t I2, uint8_t F2>
+    constexpr Fixed<I2, F2> to() const {
+        return Fixed<I2, F2>::fromRaw(Fixed<I2, F2>::saturate(
+            F2 >= F ? (int64_t)value * ((int64_t)1 << (F2 >= F ? F2 - F : 0))
+                    : (int64_t)value >> (F >= F2 ? F - F2 : 0)));
+    }
+
+    /**
+     * @brief Multiplies by NUM / DEN with a precomputed reciprocal (no division).
+     *
+     * Exact (rounded down) for raws 0..65535; other raws may come out low by
+     * up to |raw| / 65535 LSB.
+     */
+    template <typename Ratio>
+    Fixed scaled() const {
+        return fromRaw(saturate(fixedRatioApply<Ratio>((Wide)value)));
+    }
+
+    /**
+     * @brief Clamps a wide intermediate result to the range of the format.
+     */
+    template <typename W>
+    static constexpr Raw saturate(W x) {
+        return x > (W)RAW_MAX ? RAW_MAX : (x < (W)RAW_MIN ? RAW_MIN : (Raw)x);
+    }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return fromRaw(saturate((Wide)a.value + b.value)); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return fromRaw(saturate((Wide)a.value - b.value)); }
+    constexpr Fixed operator-() const { return fromRaw(saturate(-(Wide)value)); }
+
+    /**
+     * @brief Product rounded to nearest.
+     */
+    friend constexpr Fixed operator*(Fixed a, Fixed b) {
+        return fromRaw(saturate(((Wide)a.value * b.value + HALF) >> F));
+    }
+
+    /**
+     * @brief Quotient truncated towards zero; division by zero saturates.
+     */
+    friend Fixed operator/(Fixed a, Fixed b) {
+        if (b.value == 0) {
+            return a.value < 0 ? minValue() : maxValue();
+        }
+        return fromRaw(saturate((Wide)a.value * ONE / b.value));
+    }
+
+    /**
+     * @brief Product by an integer, saturated.
+     */
+    friend constexpr Fixed operator*(Fixed a, int16_t n) { return fromRaw(saturate((Wide)a.value * n)); }
+
+    Fixed& operator+=(Fixed b) { return *this = *this + b; }
+    Fixed& operator-=(Fixed b) { return *this = *this - b; }
+    Fixed& operator*=(Fixed b) { return *this = *this * b; }
+    Fixed& operator/=(Fixed b) { return *this = *this / b; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.value == b.value; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.value != b.value; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.value < b.value; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.value <= b.value; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.value > b.value; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.value >= b.value; }
+
+private:
+    static constexpr Wide ONE = (Wide)1 << F;
+    static constexpr Wide HALF = F > 0 ? ((Wide)1 << (F > 0 ? F - 1 : 0)) : 0;
+
+    constexpr Fixed(Raw raw, int) : value(raw) {}
+
+    Raw value;
+};
+
+#endif // FIXED_H
@@ -0,0 +1,124 @@
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+#include "extInt/extInt.h"
+
+/*
+ * 🎛️ Quadrature encoders and pulse counters on the external interrupts.
+ *
+ * Encoder n uses the pair INT(2n)/INT(2n+1), whose pins are adjacent bits of
+ * one port (PD0/PD1, PD2/PD3, PE4/PE5), so its state AB is one read, a shift
+ * and a mask. Both lines interrupt on every change (4 counts per cycle) and
+ * the ISR only indexes a 16-entry table with the packed previous/current
+ * state:
+ *
+ *   count += STEP[previous AB << 2 | current AB]
+ *
+ * The table gives +1, -1, or 0 for no change and for both channels changed.
+ * The last case is a missed edge, counted as a skip: skips mean the encoder
+ * ran faster than the ISR can follow.
+ *
+ * A pulse counter (flow meter, tachometer) increments a 32-bit count on the
+ * chosen edge of one line. Counts are 32 bits; reads hold interrupts off for
+ * the four-byte copy. The 'bench' command measures the cycles per edge of both
+ * ISRs and the edge rate they sustain.
+ *
+ * Lines come from ENCODER_INT_LINES (whole pairs) and COUNTER_INT_LINES.
+ *
+ *   encoderBegin(2, true);                 // INT4/INT5: pins 2 and 3
+ *   int32_t position = encoderCount(2);
+ *   pulseCounterBegin(2, EXT_INT_FALLING, true);
+ *   uint32_t litres = pulseCounterTake(2) / PULSES_PER_LITRE;
+ */
+
+// Encoder pairs (INT0/INT1, INT2/INT3, INT4/INT5)
+constexpr uint8_t ENCODER_PAIRS = EXT_INT_LINES / 2;
+
+#if FEATURE_ENCODER
+
+/**
+ * @brief Starts encoder `pair` (lines 2*pair and 2*pair+1) counting from 0.
+ *
+ * @param pullUp  Internal pull-ups (open-collector encoders).
+ * @return false if the pair is not in ENCODER_INT_LINES.
+ */
+bool encoderBegin(uint8_t pair, bool pullUp);
+
+/**
+ * @brief Stops encoder `pair`; its count is kept.
+ */
+void encoderEnd(uint8_t pair);
+
+/**
+ * @brief Position of encoder `pair` in counts (4 per cycle), read atomically.
+ */
+int32_t encoderCount(uint8_t pair);
+
+/**
+ * @brief Sets the position of encoder `pair` (homing).
+ */
+void encoderWrite(uint8_t pair, int32_t count);
+
+/**
+ * @brief Transitions where both channels changed (missed edges) on encoder `pair`.
+ */
+uint16_t encoderSkips(uint8_t pair);
+
+/**
+ * @brief Starts counting edges on `line` from 0.
+ *
+ * @param edge    EXT_INT_RISING, EXT_INT_FALLING or EXT_INT_CHANGE.
+ * @param pullUp  Internal pull-up (open-collector sensors).
+ * @return false if the line is not in COUNTER_INT_LINES.
+ */
+bool pulseCounterBegin(uint8_t line, ExtIntSense edge, bool pullUp);
+
+/**
+ * @brief Stops the counter of `line`; its count is kept.
+ */
+void pulseCounterEnd(uint8_t line);
+
+/**
+ * @brief Edges counted on `line`, read atomically.
+ */
+uint32_t pulseCounterRead(uint8_t line);
+
+/**
+ * @brief Edges counted on `line` since the previous take; no edge is lost in between.
+ */
+uint32_t pulseCounterTake(uint8_t line);
+
+/**
+ * @brief Runs the ISR body of the first encoder pair `count` times on scratch state (benchmark).
+ */
+void encoderBenchEdges(uint8_t count);
+
+/**
+ * @brief Runs the ISR body of a pulse counter `count` times on a scratch count (benchmark).
+ */
+void pulseCounterBenchEdges(uint8_t count);
+
+/**
+ * @brief Shell command "enc": prints the running encoders and counters, one per call.
+ *
+ * @return true after the last one.
+ */
+bool encoderCommand(const char* args);
+
+#else
+
+inline bool encoderBegin(uint8_t, bool) { return false; }
+inline void encoderEnd(uint8_t) {}
+inline int32_t encoderCount(uint8_t) { return 0; }
+inline void encoderWrite(uint8_t, int32_t) {}
+inline uint16_t encoderSkips(uint8_t) { return 0; }
+inline bool pulseCounterBegin(uint8_t, ExtIntSense, bool) { return false; }
+inline void pulseCounterEnd(uint8_t) {}
+inline uint32_t pulseCounterRead(uint8_t) { return 0; }
+inline uint32_t pulseCounterTake(uint8_t) { return 0; }
+
+#endif // FEATURE_ENCODER
+
+#endif // ENCODER_H
@@ -0,0 +1,66 @@
+#ifndef EXT_INT_H
+#define EXT_INT_H
+
+#include <Arduino.h>
+
+/*
+ * ⚡ External interrupt lines INT0-INT5.
+ *
+ * Lines are numbered as the hardware vectors (INTn_vect), not as
+ * attachInterrupt(): Pins::INTERRUPTS lists them in the Arduino order, where
+ * interrupt 0 is pin 2 = INT4.
+ *
+ *   INT0 = 21 (SCL)   INT1 = 20 (SDA)   INT2 = 19 (RX1)
+ *   INT3 = 18 (TX1)   INT4 = 2          INT5 = 3
+ *
+ * Each driver owns the vectors of the lines in its mask (buildConfig.h) and
+ * defines them itself, so an ISR is only the driver's own instructions. These
+ * helpers only program the sense control and the mask bits.
+ *
+ * INT0-INT3 detect edges asynchronously and wake the MCU from every sleep
+ * mode. INT4-INT7 need the I/O clock for edges (in POWER_DOWN only a low level
+ * wakes), so while one of them is enabled on an edge it holds
+ * POWER_NEED_IO_CLOCK and the power manager stays in IDLE.
+ */
+
+// Lines bonded out on the Mega (INT6/INT7 are not)
+constexpr uint8_t EXT_INT_LINES = 6;
+
+/**
+ * @brief Edge or level that raises the interrupt (ISCn1:0).
+ */
+enum ExtIntSense : uint8_t {
+    EXT_INT_LOW,
+    EXT_INT_CHANGE,
+    EXT_INT_FALLING,
+    EXT_INT_RISING
+};
+
+/**
+ * @brief Arduino pin of line `line`.
+ */
+constexpr uint8_t extIntPin(uint8_t line) {
+    return line < 4 ? 21 - line : line - 2;
+}
+
+/**
+ * @brief Current level of line `line` (a single instruction when `line` is a constant).
+ */
+inline bool extIntLevel(uint8_t line) {
+    return line < 4 ? (PIND & _BV(line)) : (PINE & _BV(line));
+}
+
+/**
+ * @brief Sets the sense of `line`, drops a stale request and enables it.
+ *
+ * @param pullUp  Input with the internal pull-up instead of floating.
+ * @return false if `line` is not bonded out.
+ */
+bool extIntEnable(uint8_t line, ExtIntSense sense, bool pullUp);
+
+/**
+ * @brief Disables `line` (the pin is left as it is) and drops its I/O clock need.
+ */
+void extIntDisable(uint8_t line);
+
+#endif // EXT_INT_H
@@ -0,0 +1,187 @@
+#ifndef LED_MATRIX_H
+#define LED_MATRIX_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Output register of one AVR port together with the bits a driver owns on it.
+ *
+ * Drivers resolve their Arduino pin numbers into this form once, so the scan
+ * interrupt only performs masked register writes instead of `digitalWrite()` calls.
+ */
+struct PortMask {
+    volatile uint8_t* out;  // PORTx register
+    volatile uint8_t* ddr;  // DDRx register
+    uint8_t mask;           // Bits of the port used by the driver
+};
+
+/**
+ * @brief Multiplexed LED matrix driven from the GPIO pins (`Pins::GPIO`).
+ *
+ * Rows are active LOW (common cathode, one row sinks current at a time) and
+ * columns are active HIGH. Rows are scanned from the Timer3 compare interrupt.
+ *
+ * The application edits a logical frame with `set()` / `clear()` and publishes
+ * it with `present()`, which converts it into precomputed port images in the
+ * back buffer and requests a flip. The interrupt only reads the front buffer
+ * and swaps buffers when it wraps to row 0, so every refresh shows a single
+ * frame, and every scan step costs the same: release one row, write one byte
+ * per column port, select the next row.
+ */
+class LedMatrix {
+public:
+    static constexpr uint8_t MAX_ROWS  = 8;   // Maximum number of rows
+    static constexpr uint8_t MAX_COLS  = 16;  // Maximum number of columns
+    static constexpr uint8_t MAX_PORTS = 4;   // Maximum distinct ports used by the columns
+
+    /**
+     * @brief Constructor of the LedMatrix class.
+     *
+     * @param rowPins  Array with the physical pin of each row.
+     * @param numRows  Number of rows (1..MAX_ROWS).
+     * @param colPins  Array with the physical pin of each column.
+     * @param numCols  Number of columns (1..MAX_COLS).
+     */
+    LedMatrix(const uint8_t* rowPins, uint8_t numRows, const uint8_t* colPins, uint8_t numCols);
+
+    /**
+     * @brief Configures the pins and starts the Timer3 scan.
+     *
+     * @param refreshHz  Full-frame refresh rate; the interrupt runs at refreshHz * rows.
+     * @return true if the pin layout is valid and the scan was started.
+     */
+    bool begin(uint16_t refreshHz = 100);
+
+    /**
+     * @brief Stops the scan and switches every LED off.
+     */
+    void end();
+
+    /**
+     * @brief Sets one LED of the back frame. Visible after `present()`.
+     */
+    void set(uint8_t row, uint8_t col, bool state);
+
+    /**
+     * @brief Clears the back frame. Visible after `present()`.
+     */
+    void clear();
+
+    /**
+     * @brief Publishes the back frame to the scan interrupt.
+     */
+    void present();
+
+    /**
+     * @brief Advances the scan by one row. Called from the Timer3 interrupt.
+     */
+    void scan();
+
+    /**
+     * @brief Entry point of the Timer3 compare interrupt.
+     */
+    static void onTimerInterrupt();
+
+private:
+    volatile uint8_t* rowOut[MAX_ROWS];         // PORTx register of each row
+    uint8_t rowBit[MAX_ROWS];                   // Bit mask of each row
+    PortMask colPorts[MAX_PORTS];               // Ports used by the columns
+    uint8_t colPort[MAX_COLS];                  // Index in colPorts of each column
+    uint8_t colBit[MAX_COLS];                   // Bit mask of each column
+    uint8_t numRows;
+    uint8_t numCols;
+    uint8_t numColPorts;
+    bool valid;
+
+    uint16_t frame[MAX_ROWS];                   // Logical back frame, one bit per column
+    uint8_t image[2][MAX_ROWS][MAX_PORTS];      // Double-buffered column port images
+    volatile uint8_t front;                     // Buffer read by the interrupt
+    volatile bool flipPending;                  // Back buffer complete, swap at row 0
+    uint8_t currentRow;                         // Row currently selected
+
+    static LedMatrix* active;                   // Matrix served by the Timer3 interrupt
+};
+
+/**
+ * @brief Charlieplexed LED array: N tri-state pins drive N * (N - 1) LEDs.
+ *
+ * LED `index` is connected with its anode on pin `index / (N - 1)` and its cathode
+ * on the remaining pins in ascending order. Anodes are scanned from the Timer2
+ * compare interrupt using precomputed DDR/PORT images per anode, double buffered
+ * in the same way as `LedMatrix`.
+ */
+class LedCharlieplex {
+public:
+    static constexpr uint8_t MAX_PINS  = 8;   // Maximum number of pins (56 LEDs)
+    static constexpr uint8_t MAX_PORTS = 4;   // Maximum distinct ports used by the pins
+
+    /**
+     * @brief Constructor of the LedCharlieplex class.
+     *
+     * @param pins     Array with the physical pins of the array.
+     * @param numPins  Number of pins (2..MAX_PINS).
+     */
+    LedCharlieplex(const uint8_t* pins, uint8_t numPins);
+
+    /**
+     * @brief Leaves the pins in high impedance and starts the Timer2 scan.
+     *
+     * @param refreshHz  Full-frame refresh rate; the interrupt runs at refreshHz * pins.
+     * @return true if the pin layout is valid and the scan was started.
+     */
+    bool begin(uint16_t refreshHz = 100);
+
+    /**
+     * @brief Stops the scan and leaves every pin in high impedance.
+     */
+    void end();
+
+    /**
+     * @brief Number of LEDs addressable with the configured pins.
+     */
+    uint8_t size() const { return numPins * (numPins - 1); }
+
+    /**
+     * @brief Sets one LED of the back frame. Visible after `present()`.
+     */
+    void set(uint8_t index, bool state);
+
+    /**
+     * @brief Clears the back frame. Visible after `present()`.
+     */
+    void clear();
+
+    /**
+     * @brief Publishes the back frame to the scan interrupt.
+     */
+    void present();
+
+    /**
+     * @brief Advances the scan by one anode. Called from the Timer2 interrupt.
+     */
+    void scan();
+
+    /**
+     * @brief Entry point of the Timer2 compare interrupt.
+     */
+    static void onTimerInterrupt();
+
+private:
+    PortMask ports[MAX_PORTS];                  // Ports used by the pins
+    uint8_t pinPort[MAX_PINS];                  // Index in ports of each pin
+    uint8_t pinBit[MAX_PINS];                   // Bit mask of each pin
+    uint8_t numPins;
+    uint8_t numPorts;
+    bool valid;
+
+    uint8_t frame[MAX_PINS];                    // Per anode, one bit per lit cathode
+    uint8_t ddrImage[2][MAX_PINS][MAX_PORTS];   // Double-buffered DDR images
+    uint8_t outImage[2][MAX_PINS][MAX_PORTS];   // Double-buffered PORT images
+    volatile uint8_t front;                     // Buffer read by the interrupt
+    volatile bool flipPending;                  // Back buffer complete, swap at anode 0
+    uint8_t currentAnode;                       // Anode currently driven
+
+    static LedCharlieplex* active;              // Array served by the Timer2 interrupt
+};
+
+#endif // LED_MATRIX_H
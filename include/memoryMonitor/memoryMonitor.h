@@ -0,0 +1,70 @@
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+
+/*
+ * 🧱 SRAM monitor: stack and heap high-water marks of the application.
+ *
+ * SRAM layout of the ATmega2560:
+ *
+ *   RAMSTART [.data][.bss][heap →      free      ← stack] RAMEND
+ *
+ * Before the C runtime initializes .data/.bss (section .init3), every byte
+ * between the start of the heap and RAMEND is painted with MEMORY_CANARY.
+ * The deepest stack usage is the lowest byte that no longer holds the canary.
+ *
+ * `memoryMonitorPoll()` runs as the scheduler idle hook and scans at most
+ * MEMORY_SCAN_BYTES per call, upwards from the top of the heap, so a pass over
+ * the free region is spread across many idle periods. When the margin between
+ * the heap peak and the stack peak falls below MEMORY_WARN_MARGIN, a warning
+ * is printed once, before the stack and the heap actually meet.
+ */
+
+// Value painted in free SRAM
+constexpr uint8_t MEMORY_CANARY = 0xC5;
+// Bytes checked per idle call
+constexpr uint8_t MEMORY_SCAN_BYTES = 64;
+// Free bytes between heap and stack peaks below which a warning is printed
+constexpr uint16_t MEMORY_WARN_MARGIN = 256;
+
+/**
+ * @brief SRAM usage snapshot, in bytes.
+ */
+struct MemoryUsage {
+    uint16_t staticBytes;   // .data + .bss
+    uint16_t heapBytes;     // Heap in use now
+    uint16_t heapPeak;      // Largest heap seen
+    uint16_t stackBytes;    // Stack in use now
+    uint16_t stackPeak;     // Deepest stack found by the canary scan
+    uint16_t freeBytes;     // Between heap and stack now
+    uint16_t margin;        // Between heap peak and stack peak: never touched
+};
+
+#if FEATURE_MEMORY_MONITOR
+
+/**
+ * @brief Installs `memoryMonitorPoll()` as the scheduler idle hook.
+ */
+void memoryMonitorBegin();
+
+/**
+ * @brief Advances the canary scan by up to MEMORY_SCAN_BYTES and checks the margin.
+ */
+void memoryMonitorPoll();
+
+/**
+ * @brief Current usage and peaks.
+ */
+MemoryUsage memoryUsage();
+
+#else
+
+inline void memoryMonitorBegin() {}
+inline void memoryMonitorPoll() {}
+inline MemoryUsage memoryUsage() { return MemoryUsage(); }
+
+#endif // FEATURE_MEMORY_MONITOR
+
+#endif // MEMORY_MONITOR_H
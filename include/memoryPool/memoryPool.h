@@ -0,0 +1,116 @@
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <Arduino.h>
+#include <new.h>
+
+/**
+ * @brief Maximum bytes a single pool may reserve (1/8 of the Mega's 8 KB SRAM).
+ */
+constexpr uint16_t POOL_MAX_BYTES = 1024;
+
+/**
+ * @brief Common part of every static pool: name, geometry and usage.
+ *
+ * Every pool registers itself in a linked list when it is constructed, so
+ * `showMemoryPoolReport()` can list how many bytes each module reserves.
+ */
+class PoolBase {
+public:
+    /**
+     * @brief Constructor of the PoolBase class. Registers the pool in the report list.
+     *
+     * @param name        Name of the module that owns the pool.
+     * @param objectSize  Size of one slot in bytes.
+     * @param capacity    Number of slots.
+     */
+    PoolBase(const char* name, uint16_t objectSize, uint8_t capacity);
+
+    const char* name() const { return poolName; }
+    uint16_t objectSize() const { return slotSize; }
+    uint8_t capacity() const { return slotCount; }
+    uint8_t used() const { return usedCount; }
+    uint16_t reservedBytes() const { return (uint16_t)slotSize * slotCount; }
+
+    /**
+     * @brief First registered pool (iterate with `next()`).
+     */
+    static const PoolBase* first() { return head; }
+    const PoolBase* next() const { return nextPool; }
+
+protected:
+    uint8_t usedCount;
+
+private:
+    const char* poolName;
+    uint16_t slotSize;
+    uint8_t slotCount;
+    const PoolBase* nextPool;
+
+    static const PoolBase* head;
+};
+
+/**
+ * @brief Typed object pool with storage reserved at compile time.
+ *
+ * Objects are built with placement new in a static slot array, so drivers never
+ * touch the heap. `create()` returns nullptr when every slot is taken.
+ *
+ * @tparam T  Type of the objects stored.
+ * @tparam N  Number of slots (1..8).
+ */
+template <typename T, uint8_t N>
+class StaticPool : public PoolBase {
+    static_assert(N > 0, "A pool needs at least one slot");
+    static_assert(N <= 8, "Slot occupancy is tracked in an 8-bit mask");
+    static_assert(sizeof(T) * N <= POOL_MAX_BYTES, "Pool exceeds POOL_MAX_BYTES");
+
+public:
+    /**
+     * @brief Constructor of the StaticPool class.
+     *
+     * @param name  Name of the module that owns the pool (shown in the report).
+     */
+    explicit StaticPool(const char* name) : PoolBase(name, sizeof(T), N), slots(0) {}
+
+    /**
+     * @brief Constructs an object in a free slot.
+     *
+     * @param args  Arguments forwarded to the constructor of T.
+     * @return Pointer to the new object, or nullptr if the pool is full.
+     */
+    template <typename... Args>
+    T* create(Args... args) {
+        for (uint8_t i = 0; i < N; ++i) {
+            const uint8_t bit = (uint8_t)(1 << i);
+            if ((slots & bit) == 0) {
+                slots |= bit;
+                ++usedCount;
+                return new (storage[i]) T(args...);
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Destroys an object created by this pool and frees its slot.
+     */
+    void destroy(T* object) {
+        if (object == nullptr) {
+            return;
+        }
+        const uint8_t i = (uint8_t)(((uint8_t*)object - storage[0]) / sizeof(T));
+        if (i >= N || (slots & (1 << i)) == 0) {
+            return;
+        }
+        object->~T();
+        slots &= (uint8_t)~(1 << i);
+        --usedCount;
+    }
+
+private:
+    alignas(T) uint8_t storage[N][sizeof(T)];
+    uint8_t slots;  // Bit i set: slot i in use
+};
+
+#endif // MEMORY_POOL_H
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "configuracion.h"
+#include "twi/twi.h"
 
 /**
  * @brief Prints an enriched log message to the serial monitor.
@@ -54,6 +55,19 @@ void standardMessage(const char* message, const char* file, const char* function
  */
 void standardErrorMessage(const char* message, const char* file, const char* function, const char* date, const char* time, int line);
 
+/**
+ * @brief Returns true when the serial transmit buffer is empty.
+ *
+ * Long outputs are printed one piece at a time, each one when this is true,
+ * so that printing never waits for the UART. Every report below has a
+ * show*Piece(piece) form for that: piece 0, 1, 2... print the header, one
+ * row each and the footer, and the first piece past the end returns false
+ * without printing. A piece is a line or a few short ones, under the 128-byte
+ * transmit buffer set in platformio.ini; only a profiler row with a wide
+ * histogram can exceed it, and then waits for the excess.
+ */
+bool serialOutputIdle();
+
 /**
  * @brief Displays the current system configuration status on the serial monitor.
  * 
@@ -65,4 +79,174 @@ void standardErrorMessage(const char* message, const char* file, const char* fun
  */
 void showConfigurationMessage(const configuracionMain& configuration);
 
+/**
+ * @brief Piece `piece` of showConfigurationMessage(): header, two fields per piece, footer.
+ */
+bool showConfigurationPiece(const configuracionMain& configuration, uint8_t piece);
+
+/**
+ * @brief Displays the memory reserved by every static driver pool.
+ *
+ * For each registered pool prints the owning module, slots in use, slot size
+ * and reserved bytes, followed by the total reserved outside the heap.
+ */
+void showMemoryPoolReport();
+
+/**
+ * @brief Piece `piece` of showMemoryPoolReport(): header, one pool per piece, total.
+ */
+bool showMemoryPoolPiece(uint8_t piece);
+
+/**
+ * @brief Displays every registered device with its timing statistics.
+ *
+ * For each row of the device registry prints its name, state, period,
+ * number of polls, mean and maximum poll time and worst start delay.
+ */
+void showDeviceRegistryReport();
+
+/**
+ * @brief Piece `piece` of showDeviceRegistryReport(): header, one device per piece, misses.
+ */
+bool showDeviceRegistryPiece(uint8_t piece);
+
+/**
+ * @brief Displays the time spent in each power mode since boot.
+ *
+ * Example:
+ * 🔋 Power modes (uptime 60000 ms):
+ * active: 412 ms (0%), 2950 wake-ups
+ * idle: 1320 ms (2%), 1480 entries
+ * power-down: 58268 ms (97%), 1470 entries
+ */
+void showPowerReport();
+
+/**
+ * @brief Piece `piece` of showPowerReport(): header, one mode per piece, footer.
+ */
+bool showPowerPiece(uint8_t piece);
+
+/**
+ * @brief Displays the profiler slots that have samples, one line each.
+ *
+ * Times in µs; `hist` lists the log2 buckets from the first to the last
+ * non-empty one, starting at the bucket shown after `@` (lower bound in µs).
+ *
+ * Example:
+ * 📊 loop n=1520 min=6.5 mean=9.0 max=41.0 hist@4.0: 12 1490 17 1
+ */
+void showProfilerReport();
+
+/**
+ * @brief Piece `piece` of showProfilerReport(): slot `piece` (empty slots print nothing).
+ */
+bool showProfilerPiece(uint8_t piece);
+
+/**
+ * @brief Displays SRAM usage: static data, heap and stack (now and peak) and margins.
+ *
+ * Example:
+ * 🧱 SRAM [bytes] static=1210 heap=0/0 stack=86/214 free=6806 margin=6768
+ */
+void showMemoryReport();
+
+/**
+ * @brief Piece `piece` of showMemoryReport(): the whole line is piece 0.
+ */
+bool showMemoryPiece(uint8_t piece);
+
+/**
+ * @brief Displays every SPSC queue with its fill level, high-water mark and overruns.
+ *
+ * Example:
+ * 📨 capture: 0/16 x 4 B, peak 3, overruns 0
+ */
+void showQueueReport();
+
+/**
+ * @brief Piece `piece` of showQueueReport(): one queue per piece.
+ */
+bool showQueuePiece(uint8_t piece);
+
+/**
+ * @brief Displays every data bus topic with its sequence number and subscribers.
+ *
+ * Example:
+ * 📡 ledRojo: seq 42, 0 subscribers
+ */
+void showBusReport();
+
+/**
+ * @brief Piece `piece` of showBusReport(): one topic per piece.
+ */
+bool showBusPiece(uint8_t piece);
+
+/**
+ * @brief Displays every sensor with its samples, errors and latency (last/max).
+ *
+ * Example:
+ * 🌡️ pot: n=1200 err=0 lat=10012/10240 us period=10 ms
+ */
+void showSensorReport();
+
+/**
+ * @brief Piece `piece` of showSensorReport(): one sensor per piece.
+ */
+bool showSensorPiece(uint8_t piece);
+
+/**
+ * @brief Displays one benchmark result: cycles per call and the time at F_CPU.
+ *
+ * Example:
+ * ⏱️ median<int16,9>: 312 cycles (19.5 us)
+ * ⏱️ encoder edge (ISR body): 58 cycles (3.6 us) max 275 kHz
+ *
+ * @param name    Entry name (PROGMEM string).
+ * @param cycles  CPU cycles per call.
+ * @param rate    Also prints the call rate the CPU could sustain (ISR entries).
+ */
+void showBenchmarkResult(const char* name, uint32_t cycles, bool rate);
+
+/**
+ * @brief Displays the I2C engine counters.
+ *
+ * Example:
+ * 🔧 I2C ok=5120 nack=2 bus=0 timeout=0
+ */
+void showTwiReport(const TwiStats& stats);
+
+/**
+ * @brief Displays the addresses that answered a scan.
+ *
+ * Example:
+ * 🔧 I2C devices: 0x3C 0x68
+ *
+ * @param found  Bitmap of 128 addresses (bit n of byte n/8).
+ */
+void showTwiScan(const uint8_t found[16]);
+
+/**
+ * @brief Displays the position of one encoder.
+ *
+ * Example:
+ * 🎛️ enc2: 1840 counts skips=0
+ */
+void showEncoderCount(uint8_t pair, int32_t count, uint16_t skips);
+
+/**
+ * @brief Displays the count of one pulse counter.
+ *
+ * Example:
+ * 🎛️ INT2: 53120 pulses
+ */
+void showPulseCount(uint8_t line, uint32_t count);
+
+/**
+ * @brief Displays the boot phase timestamps in one compact line.
+ *
+ * Example:
+ * ⏱️ Boot [us] config=96 serial=268 pins=352 devices=420 banner=101240 diag=262410
+ */
+void showBootTimingMessage();
+
 #endif // MESSAGE_RELEASE_H
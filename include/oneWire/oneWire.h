@@ -0,0 +1,81 @@
+#ifndef ONE_WIRE_H
+#define ONE_WIRE_H
+
+#include <Arduino.h>
+#include <util/crc16.h>
+#include "buildConfig.h"
+#include "timebase/timebase.h"
+
+/*
+ * 🔌 Background 1-Wire master on ICP5 (pin 48, external 4.7 kΩ pull-up).
+ *
+ * A bit-banged 1-Wire driver keeps interrupts off for every 60 µs slot and
+ * for the 960 µs reset. Here the Timer5 compare A interrupt paces the bus, one
+ * interrupt per slot: it ends the previous slot and opens the next one, and
+ * only the ~3 µs low pulse of a 1 or read slot runs inside it. The line is
+ * never sampled in software: the input capture unit latches the rising edge
+ * that ends each read slot, so how long the device held the line low is known
+ * to 62.5 ns however late the next interrupt runs. Presence is captured the
+ * same way (falling edge after the reset).
+ *
+ * A transaction is reset + presence, `writeLength` bytes written and
+ * `readLength` bytes read, LSB first. The task that started it polls
+ * `oneWireStatus()`; CRC checks and decoding stay in the task.
+ *
+ * Interrupts held off for more than ~50 µs by other code stretch the write-0
+ * slot in progress past the 120 µs limit.
+ */
+
+// Bus pin: the input capture pin of the timebase
+constexpr uint8_t ONE_WIRE_PIN = TIMEBASE_CAPTURE_PIN;
+
+/**
+ * @brief State of the last transaction.
+ */
+enum OneWireStatus : uint8_t {
+    ONE_WIRE_IDLE,          // Nothing started since boot
+    ONE_WIRE_BUSY,
+    ONE_WIRE_DONE,
+    ONE_WIRE_NO_PRESENCE,   // No device answered the reset
+    ONE_WIRE_BUS_ERROR      // The line did not rise at the end of a read slot
+};
+
+/**
+ * @brief CRC-8 of the 1-Wire ROM and scratchpads (x^8 + x^5 + x^4 + 1).
+ *
+ * @return 0 when `data` ends with its own CRC byte and is intact.
+ */
+inline uint8_t oneWireCrc8(const uint8_t* data, uint8_t length) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; ++i) {
+        crc = _crc_ibutton_update(crc, data[i]);
+    }
+    return crc;
+}
+
+#if FEATURE_ONE_WIRE
+
+/**
+ * @brief Starts a transaction in the background; the buffers must outlive it.
+ *
+ * @param writeData    Bytes to write after the reset (ROM command first).
+ * @param writeLength  Bytes to write.
+ * @param readData     Destination of the bytes read (nullptr if readLength is 0).
+ * @param readLength   Bytes to read after the writes.
+ * @return false if a transaction is running or the capture unit is in use.
+ */
+bool oneWireStart(const uint8_t* writeData, uint8_t writeLength, uint8_t* readData, uint8_t readLength);
+
+/**
+ * @brief State of the transaction in progress or of the last one.
+ */
+OneWireStatus oneWireStatus();
+
+#else
+
+inline bool oneWireStart(const uint8_t*, uint8_t, uint8_t*, uint8_t) { return false; }
+inline OneWireStatus oneWireStatus() { return ONE_WIRE_IDLE; }
+
+#endif // FEATURE_ONE_WIRE
+
+#endif // ONE_WIRE_H
@@ -55,12 +55,12 @@ namespace Pins {
      * ⚡ External interrupts
      */
     inline const PinInfo INTERRUPTS[] = {
-        {"INT_0", 2},    // INT0: button, sensor, etc.
-        {"INT_1", 3},    // INT1: button, sensor, etc.
-        {"INT_2", 21},   // INT2: shared with SCL
-        {"INT_3", 20},   // INT3: shared with SDA
-        {"INT_4", 19},   // INT4: shared with RX1
-        {"INT_5", 18}    // INT5: shared with TX1
+        {"INT_0", 2},    // INT0: button, sensor, etc. (INT4_vect)
+        {"INT_1", 3},    // INT1: button, sensor, etc. (INT5_vect)
+        {"INT_2", 21},   // INT2: shared with SCL (INT0_vect)
+        {"INT_3", 20},   // INT3: shared with SDA (INT1_vect)
+        {"INT_4", 19},   // INT4: shared with RX1 (INT2_vect)
+        {"INT_5", 18}    // INT5: shared with TX1 (INT3_vect)
     };
 
     /*
@@ -141,7 +141,18 @@ void diagnosePWM();
 // Runs both diagnostics and prints results via Serial
 void fullDiagnostics();
 
+// Incremental version of fullDiagnostics() for fast boot: one pin action per call,
+// skips pins already configured by a driver. Returns true when finished
+bool backgroundDiagnosticsStep();
+
 // Checks if a specific pin exists in the GPIO array
 bool isPinInGPIO(int pinNumber);
 
+// Marks a pin as owned by a driver (even as a plain input): the background
+// diagnostics never touch it
+void pinClaim(uint8_t pinNumber);
+
+// Returns true if a driver has claimed the pin
+bool pinClaimed(uint8_t pinNumber);
+
 #endif  // PINS_H
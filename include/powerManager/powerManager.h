@@ -0,0 +1,107 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+
+/*
+ * 🔋 Idle manager: chooses the sleep mode the scheduler uses between tasks.
+ *
+ *   IDLE        Only the CPU stops. Timers, SPI, TWI, UART and the scheduler
+ *               tick keep running; wakes on any interrupt (at most 1 ms later).
+ *   POWER_DOWN  Every clock stops. Sleeps in 32 ms watchdog slices until the
+ *               next task, or less if INTn / pin change wakes it earlier.
+ *               Timer0 is stopped, so the slept time is added to millis() and
+ *               to the scheduler clock: whole slices, plus half of a slice cut
+ *               short by another interrupt.
+ *
+ * POWER_DOWN is only used when nothing needs the I/O clock:
+ *  - detected from the hardware: timer interrupts enabled, PWM outputs active,
+ *    an ADC conversion or a serial transmission in progress;
+ *  - declared by drivers with `powerRequire()`/`powerRelease()` for work that
+ *    leaves no trace in the registers (an SPI transfer, receiving on the UART).
+ *
+ * INT0-INT3 edges and pin change interrupts wake the MCU from every mode, so
+ * sensors using them need no declaration. INT4-INT7 edges are only seen with
+ * the I/O clock running: extInt declares it for them.
+ *
+ * The serial console holds POWER_NEED_UART_RX unless `lowPower` is enabled: it
+ * is then released and the RX0 pin wakes the MCU by pin change. The character
+ * that wakes it is lost; the console stays awake for CONSOLE_AWAKE_MS after
+ * the wake-up or the last command.
+ *
+ * The watchdog oscillator is only accurate to about ±10 %, so millis() drifts
+ * by that fraction of the time spent in POWER_DOWN.
+ */
+
+/**
+ * @brief Peripherals that keep the I/O clock running while declared.
+ */
+enum PowerNeed : uint8_t {
+    POWER_NEED_IO_CLOCK = 0,   // Timers, SPI, TWI work in progress
+    POWER_NEED_UART_RX,        // Receiving complete characters on the UART
+    POWER_NEED_COUNT
+};
+
+/**
+ * @brief Modes accounted by the manager.
+ */
+enum PowerMode : uint8_t {
+    POWER_MODE_ACTIVE = 0,
+    POWER_MODE_IDLE,
+    POWER_MODE_POWER_DOWN,
+    POWER_MODE_COUNT
+};
+
+/**
+ * @brief Time spent in one mode.
+ */
+struct PowerModeStats {
+    uint32_t entries;          // Times the mode was entered
+    uint32_t totalMs;          // Accumulated time
+    uint16_t remainderMicros;  // Accumulated time below one ms
+};
+
+// Console kept awake after a wake-up or a command (lowPower enabled)
+constexpr uint16_t CONSOLE_AWAKE_MS = 30000;
+
+/**
+ * @brief Declares that `need` is in use. Calls nest; safe from interrupts.
+ */
+void powerRequire(PowerNeed need);
+
+/**
+ * @brief Releases a previous `powerRequire()`.
+ */
+void powerRelease(PowerNeed need);
+
+/**
+ * @brief Selects whether the serial console may sleep (wake on RX0 edge).
+ */
+void powerConsoleLowPower(bool enabled);
+
+/**
+ * @brief Keeps the console awake for CONSOLE_AWAKE_MS more. Call on every command.
+ */
+void powerConsoleActivity();
+
+/**
+ * @brief Sleeps in the deepest mode allowed for at most `budgetMs`.
+ *
+ * @param budgetMs  Time until the next task is due.
+ * @return ms slept with Timer0 stopped, to be added to the caller's clock.
+ * @pre Interrupts disabled (checked-then-sleep without a race).
+ * @post Interrupts enabled.
+ */
+uint16_t powerSleep(uint32_t budgetMs);
+
+/**
+ * @brief Time accounted to `mode`. ACTIVE is uptime minus the sleep modes.
+ */
+PowerModeStats powerModeStats(PowerMode mode);
+
+/**
+ * @brief Short name of a mode, for reports.
+ */
+const char* powerModeName(PowerMode mode);
+
+#endif // POWER_MANAGER_H
@@ -0,0 +1,106 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+
+/*
+ * 📊 Execution-time profiler on Timer1.
+ *
+ * Timer1 runs free (normal mode, prescaler 8): one tick is 0.5 µs and the
+ * counter wraps every 32.768 ms, so intervals up to that length are measured
+ * with two reads of TCNT1 and one 16-bit subtraction. Longer intervals alias;
+ * the scheduler statistics (micros()) still cover them.
+ *
+ * Every slot keeps count, min/max/mean and a log2 histogram: bucket b counts
+ * samples of [2^b, 2^(b+1)) ticks, bucket 0 also holds 0. A sample costs
+ * about 40 cycles, so the profiler can stay enabled in production.
+ *
+ * Slots:
+ *   PROFILE_SLOT_LOOP    Dispatch passes of the scheduler that ran tasks
+ *   PROFILE_SLOT_JITTER  Delay from the tick that released a task to its start
+ *   PROFILE_SLOT_TASK0+  One slot per scheduler task id (the first ones)
+ *
+ * @note Timer1 also provides PWM on pins 11 and 12; `analogWrite()` on those
+ *       pins is not available while the profiler runs. Timer1 stops in
+ *       POWER_DOWN, which is never entered during a measurement.
+ */
+
+// Histogram buckets: one per bit of the 16-bit interval
+constexpr uint8_t PROFILER_BUCKETS = 16;
+// Timer1 ticks per µs
+constexpr uint8_t PROFILER_TICKS_PER_US = F_CPU / 8 / 1000000UL;
+
+enum ProfileSlot : uint8_t {
+    PROFILE_SLOT_LOOP = 0,
+    PROFILE_SLOT_JITTER,
+    PROFILE_SLOT_TASK0,
+    PROFILER_SLOTS = PROFILE_SLOT_TASK0 + 8
+};
+
+/**
+ * @brief Statistics of one slot, in Timer1 ticks.
+ */
+struct ProfileStats {
+    uint32_t count;
+    uint32_t totalTicks;
+    uint16_t minTicks;
+    uint16_t maxTicks;
+    uint16_t histogram[PROFILER_BUCKETS];  // Saturate at 0xFFFF
+};
+
+#if FEATURE_PROFILER
+
+/**
+ * @brief Starts Timer1 free-running and clears every slot.
+ */
+void profilerBegin();
+
+/**
+ * @brief Current Timer1 count: start of a measurement.
+ *
+ * The 16-bit read goes through the shared TEMP register, which the tick ISR
+ * also uses (TIMER0_COMPA_vect reads TCNT1), so it runs with interrupts off.
+ */
+inline uint16_t profilerNow() {
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint16_t now = TCNT1;
+    SREG = oldSREG;
+    return now;
+}
+
+/**
+ * @brief Adds the interval `elapsedTicks` to `slot`.
+ */
+void profilerRecord(uint8_t slot, uint16_t elapsedTicks);
+
+/**
+ * @brief Ends a measurement started with `profilerNow()`.
+ */
+inline void profilerStop(uint8_t slot, uint16_t startTicks) {
+    profilerRecord(slot, profilerNow() - startTicks);
+}
+
+/**
+ * @brief Statistics of `slot`, nullptr if out of range.
+ */
+const ProfileStats* profilerStats(uint8_t slot);
+
+/**
+ * @brief Clears every slot.
+ */
+void profilerReset();
+
+#else
+
+inline void profilerBegin() {}
+inline uint16_t profilerNow() { return 0; }
+inline void profilerRecord(uint8_t, uint16_t) {}
+inline void profilerStop(uint8_t, uint16_t) {}
+inline const ProfileStats* profilerStats(uint8_t) { return nullptr; }
+inline void profilerReset() {}
+
+#endif // FEATURE_PROFILER
+
+#endif // PROFILER_H
@@ -0,0 +1,121 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+/*
+ * ⏲️ Time-triggered cooperative scheduler.
+ *
+ * The tick is the Timer0 compare-match A interrupt: Timer0 already runs for
+ * millis() (fast PWM, prescaler 64, 1024 µs per cycle), so the scheduler adds
+ * an interrupt on the same timer instead of taking another one. The ISR keeps a
+ * millisecond counter with the same fractional correction as the core.
+ *
+ * Tasks are plain functions kept in a fixed table in RAM. loop() calls
+ * `schedulerRun()`, which runs every task that is due (highest priority first,
+ * then earliest release) and, when nothing is due, sleeps until the next
+ * interrupt in the mode chosen by the power manager (powerManager.h).
+ *
+ * Tasks must return quickly: a task that runs past its deadline is counted as
+ * a deadline miss, and a periodic task that overruns a whole period skips the
+ * releases it lost instead of running back to back.
+ */
+
+typedef void (*TaskFunction)();
+
+/**
+ * @brief Task priorities, lower value runs first.
+ */
+enum TaskPriority : uint8_t {
+    TASK_PRIORITY_HIGH = 0,
+    TASK_PRIORITY_NORMAL,
+    TASK_PRIORITY_LOW
+};
+
+/**
+ * @brief Timing statistics of one task.
+ */
+struct TaskStats {
+    uint32_t runs;            // Number of executions
+    uint32_t totalMicros;     // Accumulated execution time
+    uint16_t maxMicros;       // Longest execution
+    uint16_t maxLateMs;       // Worst delay between release and start
+    uint16_t deadlineMisses;  // Executions finished after the deadline, plus skipped releases
+};
+
+// Size of the task table
+constexpr uint8_t MAX_TASKS = 16;
+// Returned when a task cannot be added
+constexpr uint8_t INVALID_TASK = 0xFF;
+
+/**
+ * @brief Enables the tick interrupt. Call once from setup() before adding tasks.
+ */
+void schedulerBegin();
+
+/**
+ * @brief Adds a periodic task, first released one period from now.
+ *
+ * @param function    Task body.
+ * @param periodMs    Period in ms (0 is treated as 1: every tick).
+ * @param priority    Dispatch priority.
+ * @param deadlineMs  Relative deadline in ms; 0 = the period.
+ * @return Task id, or INVALID_TASK if the table is full.
+ */
+uint8_t schedulerAddPeriodic(TaskFunction function, uint16_t periodMs, TaskPriority priority, uint16_t deadlineMs = 0);
+
+/**
+ * @brief Adds a task that runs once, `delayMs` from now, and is then removed.
+ *
+ * @param function    Task body.
+ * @param delayMs     Delay in ms.
+ * @param priority    Dispatch priority.
+ * @param deadlineMs  Relative deadline in ms from the release; 0 = no deadline.
+ * @return Task id, or INVALID_TASK if the table is full.
+ */
+uint8_t schedulerAddOneShot(TaskFunction function, uint16_t delayMs, TaskPriority priority, uint16_t deadlineMs = 0);
+
+/**
+ * @brief Removes a task. Safe to call from a task, including on itself.
+ */
+void schedulerRemove(uint8_t id);
+
+/**
+ * @brief Called from a task: its next release is `delayMs` from the end of
+ *        this run instead of its next period (one-shot tasks stay registered).
+ *
+ * Used by CORO_DELAY so that a waiting coroutine costs nothing until it is due.
+ * Ignored outside a task.
+ */
+void schedulerDefer(uint16_t delayMs);
+
+/**
+ * @brief Runs the due tasks, or sleeps until the next interrupt. Call from loop().
+ *
+ * In POWER_DOWN the tick stops; the slept time is added to the clock on wake-up.
+ */
+void schedulerRun();
+
+/**
+ * @brief Sets the function called on every idle pass, before sleeping.
+ *
+ * The hook must be short (tens of µs); nullptr removes it.
+ */
+void schedulerSetIdleHook(TaskFunction hook);
+
+/**
+ * @brief Scheduler time in ms, counted by the tick interrupt.
+ */
+uint32_t schedulerMillis();
+
+/**
+ * @brief Statistics of task `id`, nullptr if the id is not in use.
+ */
+const TaskStats* schedulerTaskStats(uint8_t id);
+
+/**
+ * @brief Total deadline misses since boot, all tasks included.
+ */
+uint32_t schedulerDeadlineMisses();
+
+#endif // SCHEDULER_H
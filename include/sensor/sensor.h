@@ -0,0 +1,187 @@
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <Arduino.h>
+
+/*
+ * 🌡️ Non-blocking sensor base.
+ *
+ * A sensor is a small subclass of `Sensor<Derived, T, PERIOD_MS>` (CRTP: no
+ * virtual calls, no vtable in SRAM) that implements two steps:
+ *
+ *   bool trigger();          // starts a conversion; false = bus/device error
+ *   SensorStep read(T& v);   // SENSOR_BUSY until the sample is in `v`
+ *
+ * Neither may wait. `poll()` is the body of the sensor's device task, run every
+ * `PERIOD` ms: it advances the conversion in progress and, once it ends,
+ * triggers the next one, so a sensor faster than its period delivers one sample
+ * per period. The consumer checks `ready()` and takes the sample with `latest()`.
+ *
+ * Every sensor keeps its statistics (samples, errors and trigger-to-sample
+ * latency) and registers itself for `showSensorReport()`, like the queues.
+ */
+
+// A conversion still busy after this many periods is abandoned as an error
+constexpr uint8_t SENSOR_TIMEOUT_PERIODS = 4;
+
+/**
+ * @brief Result of one `read()` step.
+ */
+enum SensorStep : uint8_t {
+    SENSOR_BUSY,
+    SENSOR_DONE,
+    SENSOR_ERROR
+};
+
+/**
+ * @brief Statistics of one sensor.
+ */
+struct SensorStats {
+    uint32_t samples;
+    uint16_t errors;           // Trigger failures, read errors and timeouts
+    uint32_t lastLatencyUs;    // trigger() to the poll that got the sample
+    uint32_t maxLatencyUs;
+};
+
+/**
+ * @brief Common part of every sensor: name, period, state and statistics.
+ */
+class SensorBase {
+public:
+    /**
+     * @brief Constructor of the SensorBase class. Registers the sensor in the report list.
+     *
+     * @param name      Name shown in the report.
+     * @param periodMs  Sampling period of the sensor task.
+     */
+    SensorBase(const char* name, uint16_t periodMs);
+
+    const char* name() const { return sensorName; }
+    uint16_t periodMs() const { return period; }
+
+    /**
+     * @brief True while a conversion is in progress.
+     */
+    bool busy() const { return converting; }
+
+    /**
+     * @brief True if a sample arrived since the last `latest()`.
+     */
+    bool ready() const { return fresh; }
+
+    const SensorStats& stats() const { return counters; }
+
+    /**
+     * @brief Clears the statistics.
+     */
+    void resetStats();
+
+    /**
+     * @brief First registered sensor (iterate with `next()`).
+     */
+    static const SensorBase* first() { return headSensor; }
+    const SensorBase* next() const { return nextSensor; }
+
+protected:
+    /**
+     * @brief Marks the start of a conversion (latency reference).
+     */
+    void conversionStarted();
+
+    /**
+     * @brief Ends the conversion in progress and counts its result.
+     */
+    void conversionFinished(SensorStep result);
+
+    /**
+     * @brief True if the conversion in progress exceeded SENSOR_TIMEOUT_PERIODS.
+     */
+    bool conversionTimedOut() const;
+
+    bool fresh;
+
+private:
+    const char* sensorName;
+    uint16_t period;
+    bool converting;
+    uint32_t startMicros;
+    SensorStats counters;
+    const SensorBase* nextSensor;
+
+    static const SensorBase* headSensor;
+};
+
+/**
+ * @brief Sensor with a compile-time sample type and sampling period.
+ *
+ * @tparam Derived    The subclass (provides `trigger()` and `read()`).
+ * @tparam T          Sample type.
+ * @tparam PERIOD_MS  Sampling period: the period of the task that calls `poll()`.
+ */
+template <typename Derived, typename T, uint16_t PERIOD_MS>
+class Sensor : public SensorBase {
+    static_assert(PERIOD_MS > 0, "Sensor period must be at least 1 ms");
+
+public:
+    typedef T Sample;
+
+    // Period to give the sensor's entry in the device table
+    static constexpr uint16_t PERIOD = PERIOD_MS;
+
+    /**
+     * @brief Constructor of the Sensor class.
+     *
+     * @param name  Name shown in the report.
+     */
+    explicit Sensor(const char* name) : SensorBase(name, PERIOD_MS), sample() {}
+
+    /**
+     * @brief Starts a conversion unless one is in progress.
+     *
+     * @return false if busy or if the trigger failed (counted as an error).
+     */
+    bool start() {
+        if (busy()) {
+            return false;
+        }
+        conversionStarted();
+        if (!static_cast<Derived*>(this)->trigger()) {
+            conversionFinished(SENSOR_ERROR);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Advances the conversion in progress; starts the next one when it ends.
+     */
+    void poll() {
+        if (busy()) {
+            T value;
+            SensorStep result = static_cast<Derived*>(this)->read(value);
+            if (result == SENSOR_BUSY) {
+                if (!conversionTimedOut()) {
+                    return;
+                }
+                result = SENSOR_ERROR;
+            } else if (result == SENSOR_DONE) {
+                sample = value;
+            }
+            conversionFinished(result);
+        }
+        start();
+    }
+
+    /**
+     * @brief Latest sample (by reference, without copying); clears `ready()`.
+     */
+    const T& latest() {
+        fresh = false;
+        return sample;
+    }
+
+private:
+    T sample;
+};
+
+#endif // SENSOR_H
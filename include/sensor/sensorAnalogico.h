@@ -0,0 +1,71 @@
+#ifndef SENSOR_ANALOGICO_H
+#define SENSOR_ANALOGICO_H
+
+#include <Arduino.h>
+#include "sensor/sensor.h"
+#include "msg/msg.h"
+
+// Sensor analógico cuya conversión ocupa el ADC (nullptr = libre)
+inline const void* propietarioAdc = nullptr;
+
+/**
+ * @brief Entrada analógica leída sin bloquear (ADC, 10 bits).
+ *
+ * trigger() arranca la conversión y read() comprueba ADSC en la siguiente
+ * llamada, en lugar de esperar ~112 µs dentro de analogRead(). Varios sensores
+ * comparten el ADC: el que lo encuentra ocupado cuenta un error y lo intenta
+ * en el siguiente periodo. No mezclar con analogRead().
+ *
+ * @tparam PERIOD_MS Periodo de muestreo.
+ */
+template <uint16_t PERIOD_MS>
+class SensorAnalogico : public Sensor<SensorAnalogico<PERIOD_MS>, uint16_t, PERIOD_MS> {
+public:
+    /**
+     * @brief Constructor de la clase SensorAnalogico.
+     *
+     * @param name   Nombre en el informe de sensores.
+     * @param canal  Canal del ADC (0-15, A0-A15).
+     */
+    SensorAnalogico(const char* name, uint8_t canal) :
+        Sensor<SensorAnalogico<PERIOD_MS>, uint16_t, PERIOD_MS>(name),
+        canal(canal)
+        {}
+
+    /**
+     * @brief Selecciona el canal (referencia AVcc) y arranca la conversión.
+     *
+     * @return false si el canal no existe o el ADC está ocupado por otra conversión.
+     */
+    bool trigger() {
+        if (canal > 15) {
+            standardErrorMessage("El canal analógico no existe", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            return false;
+        }
+        if (propietarioAdc != nullptr && propietarioAdc != this) {
+            return false;
+        }
+        propietarioAdc = this;
+        ADCSRB = (ADCSRB & ~_BV(MUX5)) | ((canal >> 3) << MUX5);
+        ADMUX = _BV(REFS0) | (canal & 0x07);
+        ADCSRA |= _BV(ADSC);
+        return true;
+    }
+
+    /**
+     * @brief Recoge el resultado cuando el ADC ha terminado.
+     */
+    SensorStep read(uint16_t& valor) {
+        if (ADCSRA & _BV(ADSC)) {
+            return SENSOR_BUSY;
+        }
+        valor = ADC;
+        propietarioAdc = nullptr;
+        return SENSOR_DONE;
+    }
+
+private:
+    uint8_t canal;
+};
+
+#endif // SENSOR_ANALOGICO_H
@@ -0,0 +1,101 @@
+#ifndef SENSOR_DHT_H
+#define SENSOR_DHT_H
+
+#include <Arduino.h>
+#include "sensor/sensor.h"
+
+/*
+ * 💧 DHT11/DHT22 leído sin bloquear, en el pin 48 (ICP5).
+ *
+ * Las librerías habituales leen la trama de 40 bits con un bucle que mide
+ * cada pulso con las interrupciones desactivadas durante ~5 ms. Aquí la
+ * unidad de captura del timebase guarda el instante de cada flanco de bajada
+ * en un buffer (modo grabación: la ISR sólo copia ICR5) y la tarea decodifica
+ * la trama completa después: cada bit es el intervalo entre dos flancos de
+ * bajada (~78 µs un 0, ~120 µs un 1). Los intervalos y la suma de control se
+ * comprueban en la tarea, fuera de la ISR.
+ *
+ * Secuencia (un paso por llamada a read(), con schedulerDefer entre ellos):
+ *  1. pulso de inicio: línea a 0 durante 2 ms (DHT22) o 20 ms (DHT11);
+ *  2. libera la línea (pull-up) y espera los 42 flancos (~5 ms);
+ *  3. decodifica.
+ * trigger() sólo arma la secuencia: el pulso de inicio sale en la siguiente
+ * llamada, así el sensor se lee una vez por periodo.
+ */
+
+// Mínimo entre lecturas que admiten los dos modelos
+constexpr uint16_t DHT_PERIOD_MS = 2000;
+
+// Flancos de bajada de una trama: respuesta, 40 bits y fin de trama
+constexpr uint8_t DHT_EDGES = 42;
+
+/**
+ * @brief Modelo del sensor (cambian el pulso de inicio y el formato de los datos).
+ */
+enum DhtModelo : uint8_t {
+    DHT_MODELO_11,
+    DHT_MODELO_22
+};
+
+/**
+ * @brief Muestra de un DHT.
+ */
+struct DhtSample {
+    int16_t temperatura;    // Décimas de °C
+    uint16_t humedad;       // Décimas de %HR
+};
+
+/**
+ * @brief Sensor DHT11/DHT22 decodificado con captura de flancos.
+ */
+class SensorDht : public Sensor<SensorDht, DhtSample, DHT_PERIOD_MS> {
+public:
+    /**
+     * @brief Constructor de la clase SensorDht.
+     *
+     * @param name    Nombre en el informe de sensores.
+     * @param modelo  DHT11 o DHT22 (AM2302).
+     */
+    SensorDht(const char* name, DhtModelo modelo);
+
+    /**
+     * @brief Arma la secuencia; abandona la anterior si quedó a medias.
+     */
+    bool trigger();
+
+    /**
+     * @brief Avanza la secuencia un paso.
+     *
+     * @return SENSOR_ERROR si la captura está ocupada, falta algún flanco o la trama no es válida.
+     */
+    SensorStep read(DhtSample& valor);
+
+private:
+    /**
+     * @brief Paso pendiente de la secuencia.
+     */
+    enum Fase : uint8_t {
+        FASE_ARMADO,
+        FASE_INICIO,
+        FASE_RECIBIENDO
+    };
+
+    /**
+     * @brief Libera la línea y la unidad de captura.
+     */
+    void terminar();
+
+    /**
+     * @brief Convierte los flancos grabados en una muestra.
+     *
+     * @return false si algún intervalo está fuera de rango o falla la suma de control.
+     */
+    bool decodificar(DhtSample& valor) const;
+
+    DhtModelo modelo;
+    Fase fase;
+    uint16_t marca;                        // Inicio del paso actual (ms, 16 bits)
+    volatile uint16_t flancos[DHT_EDGES];  // ICR5 de cada flanco de bajada
+};
+
+#endif // SENSOR_DHT_H
@@ -0,0 +1,90 @@
+#ifndef SENSOR_DS18B20_H
+#define SENSOR_DS18B20_H
+
+#include <Arduino.h>
+#include "sensor/sensor.h"
+#include "oneWire/oneWire.h"
+#include "scheduler/scheduler.h"
+#include "dsp/fixed.h"
+
+// Conversión a 12 bits (valor por defecto del DS18B20)
+constexpr uint16_t DS18B20_CONVERSION_MS = 750;
+
+// Temperatura en °C con 4 bits fraccionarios: el formato del propio sensor
+typedef Fixed<11, 4> Ds18b20Sample;
+
+/**
+ * @brief Termómetro DS18B20, único dispositivo del bus 1-Wire (Skip ROM), alimentación externa.
+ *
+ * trigger() lanza "Convert T" en segundo plano y la conversión corre sola
+ * durante el periodo; read() lanza entonces "Read Scratchpad" (9 bytes,
+ * ~7 ms de slots servidos por la ISR) y comprueba el CRC en la tarea.
+ *
+ * @tparam PERIOD_MS Periodo de muestreo (al menos la duración de la conversión).
+ */
+template <uint16_t PERIOD_MS = 1000>
+class SensorDs18b20 : public Sensor<SensorDs18b20<PERIOD_MS>, Ds18b20Sample, PERIOD_MS> {
+    static_assert(PERIOD_MS >= DS18B20_CONVERSION_MS, "El periodo del DS18B20 no cubre la conversión");
+
+public:
+    /**
+     * @brief Constructor de la clase SensorDs18b20.
+     *
+     * @param name  Nombre en el informe de sensores.
+     */
+    explicit SensorDs18b20(const char* name) :
+        Sensor<SensorDs18b20<PERIOD_MS>, Ds18b20Sample, PERIOD_MS>(name),
+        leyendo(false),
+        scratchpad()
+        {}
+
+    /**
+     * @brief Lanza la conversión.
+     *
+     * @return false si el bus está ocupado.
+     */
+    bool trigger() {
+        static const uint8_t convertir[] = { 0xCC, 0x44 };   // Skip ROM, Convert T
+        leyendo = false;
+        return oneWireStart(convertir, sizeof(convertir), nullptr, 0);
+    }
+
+    /**
+     * @brief Lee el scratchpad tras la conversión y lo valida.
+     *
+     * @return SENSOR_ERROR si no hay dispositivo, falla el bus o el CRC.
+     */
+    SensorStep read(Ds18b20Sample& valor) {
+        static const uint8_t leer[] = { 0xCC, 0xBE };        // Skip ROM, Read Scratchpad
+
+        const OneWireStatus estado = oneWireStatus();
+        if (estado == ONE_WIRE_BUSY) {
+            schedulerDefer(1);
+            return SENSOR_BUSY;
+        }
+        if (estado != ONE_WIRE_DONE) {
+            return SENSOR_ERROR;
+        }
+
+        if (!leyendo) {
+            if (!oneWireStart(leer, sizeof(leer), scratchpad, sizeof(scratchpad))) {
+                return SENSOR_ERROR;
+            }
+            leyendo = true;
+            schedulerDefer(8);
+            return SENSOR_BUSY;
+        }
+
+        if (oneWireCrc8(scratchpad, sizeof(scratchpad)) != 0) {
+            return SENSOR_ERROR;
+        }
+        valor = Ds18b20Sample::fromRaw((int16_t)(((uint16_t)scratchpad[1] << 8) | scratchpad[0]));
+        return SENSOR_DONE;
+    }
+
+private:
+    bool leyendo;              // La transacción en curso es la lectura
+    uint8_t scratchpad[9];     // Temperatura LSB/MSB, ..., CRC
+};
+
+#endif // SENSOR_DS18B20_H
@@ -0,0 +1,87 @@
+#ifndef SENSOR_ULTRASONIDO_H
+#define SENSOR_ULTRASONIDO_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+#include "sensor/sensor.h"
+
+/*
+ * 🦇 Telémetro ultrasónico tipo HC-SR04 sin pulseIn().
+ *
+ * pulseIn() espera el eco con un bucle de hasta 30 ms por lectura. Aquí el
+ * pin ECHO va a una línea de interrupción externa (ULTRASONIC_INT_LINES) cuya
+ * ISR sólo guarda timebaseNow() en cada flanco: el ancho del eco se mide en
+ * ticks de 62,5 ns y la latencia de entrada a la ISR, igual en los dos
+ * flancos, se cancela. La tarea comprueba el eco cada pocos ms y convierte
+ * el ancho a milímetros (343 m/s).
+ *
+ * Disparo escalonado: sólo un sensor tiene el eco en vuelo y entre dos
+ * disparos pasan al menos ULTRASONIDO_CICLO_MS, para que los rebotes de uno
+ * no lleguen a otro. Un sensor que encuentra el turno ocupado espera dentro
+ * de su conversión, así varios sensores con el mismo periodo se alternan
+ * solos. Como en SensorDht, trigger() sólo arma y el disparo sale en la
+ * siguiente llamada.
+ */
+
+#if FEATURE_ULTRASONIC
+
+// Mínimo entre dos disparos de cualquier sensor
+constexpr uint16_t ULTRASONIDO_CICLO_MS = 60;
+
+// Periodo de cada sensor: dos sensores caben en él sin esperar turno
+constexpr uint16_t ULTRASONIDO_PERIOD_MS = 2 * ULTRASONIDO_CICLO_MS;
+
+// Alcance máximo: un eco más largo (hasta ~38 ms sin obstáculo) es un error
+constexpr uint16_t ULTRASONIDO_MAX_MM = 4000;
+
+/**
+ * @brief Sensor ultrasónico; la muestra es la distancia en mm.
+ */
+class SensorUltrasonido : public Sensor<SensorUltrasonido, uint16_t, ULTRASONIDO_PERIOD_MS> {
+public:
+    /**
+     * @brief Constructor de la clase SensorUltrasonido.
+     *
+     * @param name        Nombre en el informe de sensores.
+     * @param pinDisparo  Pin TRIG (cualquier salida digital).
+     * @param lineaEco    Línea INTn del pin ECHO (extInt.h), incluida en ULTRASONIC_INT_LINES.
+     */
+    SensorUltrasonido(const char* name, uint8_t pinDisparo, uint8_t lineaEco);
+
+    /**
+     * @brief Arma el disparo; abandona la medida anterior si quedó a medias.
+     *
+     * @return false si la línea del eco no pertenece al ultrasonido.
+     */
+    bool trigger();
+
+    /**
+     * @brief Espera el turno, dispara y recoge el eco.
+     *
+     * @return SENSOR_ERROR si el eco no llega o supera el alcance.
+     */
+    SensorStep read(uint16_t& mm);
+
+private:
+    /**
+     * @brief Paso pendiente de la medida.
+     */
+    enum Fase : uint8_t {
+        FASE_TURNO,
+        FASE_ECO
+    };
+
+    /**
+     * @brief Desactiva la línea del eco y cede el turno.
+     */
+    void terminar();
+
+    uint8_t pinDisparo;
+    uint8_t lineaEco;
+    Fase fase;
+    uint16_t marca;          // Instante del disparo (ms, 16 bits)
+};
+
+#endif // FEATURE_ULTRASONIC
+
+#endif // SENSOR_ULTRASONIDO_H
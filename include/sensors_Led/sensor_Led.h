@@ -43,6 +43,13 @@ public:
      */
     void conmutacionEstado();
 
+    /**
+     * @brief Devuelve el estado actual del LED.
+     * 
+     * @return true si el LED está encendido.
+     */
+    bool estado() const;
+
      /**
      * @brief Produce una alternacia de estado por tiempo.
      * 
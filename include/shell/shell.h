@@ -0,0 +1,66 @@
+#ifndef SHELL_H
+#define SHELL_H
+
+#include <Arduino.h>
+
+/*
+ * 💬 Serial command shell.
+ *
+ * Characters are received by the UART RX interrupt of HardwareSerial into its
+ * ring buffer; `shellPoll()` (a device task) moves at most one buffer worth of
+ * them per call into the line buffer and dispatches a line when it ends.
+ *
+ * Commands live in a flash table sorted by name and are found by binary
+ * search. A handler returns true when it has finished; a handler that returns
+ * false is called again on the next poll with the same arguments (input is not
+ * read meanwhile), so long outputs are produced a piece at a time and never
+ * stop the sensor tasks.
+ *
+ *   bench                → cycles per call: filters, fixed vs float, SPI, ISR edges (one per poll)
+ *   bus                  → data bus topics: sequence and subscribers
+ *   cfg                  → prints the current configuration
+ *   cfg <field> <0|1>    → patches a field, re-initializes it in place and saves it
+ *   cfg reset            → restores the compiled-in defaults
+ *   dev                  → device registry and its timing statistics
+ *   diag                 → every report, one per poll
+ *   enc                  → running encoders (counts, skips) and pulse counters
+ *   help                 → list of commands
+ *   mem                  → stack/heap usage, peaks and margin
+ *   prof [reset]         → prints (or clears) the execution-time profiler
+ *   pwr                  → time spent in each power mode
+ *   queues               → ISR queues: fill, peak and overruns
+ *   sensors              → samples, errors and latency of every sensor
+ *   twi [scan]           → I2C engine counters, or probes every address
+ */
+
+/**
+ * @brief Handler of one command.
+ *
+ * @param args  Text after the command name, leading spaces removed (may be empty).
+ * @return true when finished; false to be called again on the next poll.
+ */
+typedef bool (*ShellHandler)(const char* args);
+
+/**
+ * @brief Entry of the command table (lives in PROGMEM).
+ */
+struct ShellCommand {
+    const char* name;      // PROGMEM string, table sorted by name
+    ShellHandler handler;
+    const char* help;      // PROGMEM string
+};
+
+// Longest command line, terminator excluded
+constexpr uint8_t SHELL_LINE_LENGTH = 40;
+
+/**
+ * @brief Checks the command table order. Call once from setup().
+ */
+void shellBegin();
+
+/**
+ * @brief Receives characters and runs (or continues) the current command.
+ */
+void shellPoll();
+
+#endif // SHELL_H
@@ -0,0 +1,171 @@
+#ifndef SHIFT_REGISTER_LED_H
+#define SHIFT_REGISTER_LED_H
+
+#include <Arduino.h>
+#include "spiBus/spiBus.h"
+#include "pinout/pinout.h"
+
+/**
+ * @brief Bank of LEDs on a chain of 74HC595 shift registers, a device of the SPI bus.
+ *
+ * Wiring (pins from `Pins::SPI`):
+ *   - MOSI (51) → SER of the first register
+ *   - SCK  (52) → SRCLK of every register
+ *   - latch pin (SS, 53, by default) → RCLK of every register
+ *
+ * The latch is the chip select of the bank: it falls when the transfer starts
+ * and its rising edge at the end copies the chain to the outputs. Several banks
+ * can share the bus with other SPI devices, each with its own latch pin.
+ *
+ * The LED state lives in a bit-packed shadow (LED `i` is bit `i % 8` of register
+ * `i / 8`, QA = bit 0). Changing a LED marks the bank dirty and queues a transfer
+ * if none is pending; the SPI engine sends it from its interrupt so the caller
+ * never waits. Changes made while a transfer is pending are coalesced into a
+ * single follow-up transfer, queued by the completion callback. If the bus
+ * queue is full, a scheduler task retries 1 ms later until it is accepted.
+ *
+ * A daisy chain can only be updated by shifting every register, so the dirty
+ * tracking decides *whether* a transfer happens; each transfer sends a snapshot
+ * of the whole chain and latches it at once, so the outputs never show a mix of
+ * old and new bytes.
+ */
+class ShiftRegisterBank {
+public:
+    static constexpr uint8_t MAX_REGISTERS = 8;  // 64 LEDs
+
+    /**
+     * @brief Constructor of the ShiftRegisterBank class.
+     *
+     * @param numRegisters  Number of 74HC595 in the chain (1..MAX_REGISTERS).
+     * @param latchPin      RCLK of the chain (chip select on the SPI bus).
+     */
+    explicit ShiftRegisterBank(uint8_t numRegisters, uint8_t latchPin = Pins::SPI[3].number);
+
+    /**
+     * @brief Registers the bank on the SPI bus and clears every output.
+     *
+     * Mode 0, MSB first, 1 MHz: one byte every 128 cycles, enough for the
+     * interrupt to return before the next byte is due.
+     *
+     * @return true if the chain length is valid.
+     */
+    bool begin();
+
+    /**
+     * @brief Number of LEDs in the bank.
+     */
+    uint8_t size() const { return numRegisters * 8; }
+
+    /**
+     * @brief Turns LED `index` on.
+     */
+    void on(uint8_t index);
+
+    /**
+     * @brief Turns LED `index` off.
+     */
+    void off(uint8_t index);
+
+    /**
+     * @brief Toggles LED `index`.
+     */
+    void conmutacionEstado(uint8_t index);
+
+    /**
+     * @brief Sets LED `index` to the given state.
+     */
+    void write(uint8_t index, bool state);
+
+    /**
+     * @brief Returns the shadow state of LED `index`.
+     */
+    bool read(uint8_t index) const;
+
+    /**
+     * @brief true while a transfer is queued or in progress.
+     */
+    bool busy() const { return !spiFinished(transfer); }
+
+    /**
+     * @brief Number of transfers completed (each one latched a full snapshot).
+     */
+    uint16_t transfers() const;
+
+private:
+    /**
+     * @brief Queues a transfer of the shadow, or marks the bank dirty if one is pending.
+     */
+    void requestTransfer();
+
+    /**
+     * @brief Copies the shadow into the snapshot (furthest register first) and queues it.
+     *
+     * @return false if the bus queue was full (the bank stays dirty).
+     */
+    bool submitSnapshot();
+
+    /**
+     * @brief Completion callback (SPI interrupt): counts the latch, resends if dirty.
+     */
+    static void onTransferComplete(SpiTransfer& transfer);
+
+    /**
+     * @brief Scheduler task: requests a transfer again for every stalled bank.
+     */
+    static void retryStalled();
+
+    uint8_t numRegisters;
+    uint8_t shadow[MAX_REGISTERS];     // Bit-packed LED state edited by the application
+    uint8_t txBuffer[MAX_REGISTERS];   // Snapshot being shifted out
+    SpiDevice device;
+    SpiTransfer transfer;
+    volatile bool dirty;               // Shadow changed while a transfer was pending
+    volatile uint16_t transferCount;
+    bool valid;
+    bool stalled;                      // In the retry list: the bus queue was full
+    ShiftRegisterBank* nextStalled;
+
+    static ShiftRegisterBank* firstStalled;
+    static bool retryArmed;
+};
+
+/**
+ * @brief Single LED of a ShiftRegisterBank with the same interface as LedBasicoDigital.
+ */
+class ShiftRegisterLed {
+public:
+    /**
+     * @brief Constructor of the ShiftRegisterLed class.
+     *
+     * @param bank   Bank the LED belongs to.
+     * @param index  Position of the LED in the bank.
+     */
+    ShiftRegisterLed(ShiftRegisterBank& bank, uint8_t index);
+
+    /**
+     * @brief Turns the LED on.
+     */
+    void on();
+
+    /**
+     * @brief Turns the LED off.
+     */
+    void off();
+
+    /**
+     * @brief Toggles the LED.
+     */
+    void conmutacionEstado();
+
+    /**
+     * @brief Toggles the LED every `tiempoAlternacia` milliseconds when called from loop().
+     */
+    void conmutacionEstadoPorTiempo(unsigned long tiempoAlternacia);
+
+private:
+    ShiftRegisterBank& bank;
+    uint8_t index;
+    unsigned long lastToggleTime;
+};
+
+#endif // SHIFT_REGISTER_LED_H
@@ -0,0 +1,155 @@
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+
+/*
+ * 🔄 Interrupt-driven SPI master shared by several devices (Pins::SPI).
+ *
+ * Each `SpiDevice` keeps its own clock, mode, bit order and chip-select pin,
+ * resolved once in `begin()` to SPCR/SPSR values and a port/mask pair, so
+ * switching devices costs three register writes.
+ *
+ * Drivers describe a transfer in an `SpiTransfer` they own and queue it with
+ * `spiSubmit()`. The SPI transfer-complete ISR selects the device, shifts the
+ * bytes one per interrupt, deselects it (CS rises: it also works as the latch
+ * of a 74HC595 chain) and moves straight on to the next queued transfer.
+ * Completion callbacks run inside the ISR, after the next transfer has been
+ * taken from the queue: keep them short; they may submit, and always find a
+ * free slot.
+ *
+ * For a few bytes at a fast clock the interrupt entry costs more than the
+ * byte itself: `spiTransferBurst()` sends up to SPI_BURST_BYTES in a tight
+ * polling loop instead, when the bus is free.
+ *
+ * The engine owns SPI_STC_vect.
+ */
+
+// Longest transfer accepted by spiTransferBurst()
+constexpr uint8_t SPI_BURST_BYTES = 16;
+
+// Transfers waiting for the bus
+constexpr uint8_t SPI_QUEUE_LENGTH = 8;
+
+// Byte sent when a transfer has no transmit buffer
+constexpr uint8_t SPI_FILL_BYTE = 0xFF;
+
+/**
+ * @brief State of a transfer.
+ */
+enum SpiStatus : uint8_t {
+    SPI_IDLE = 0,   // Never submitted
+    SPI_QUEUED,
+    SPI_BUSY,
+    SPI_DONE
+};
+
+/**
+ * @brief Device on the bus: chip select and bus settings.
+ */
+class SpiDevice {
+public:
+    /**
+     * @brief Constructor of the SpiDevice class.
+     *
+     * @param csPin     Chip-select pin (active low).
+     * @param clockHz   Highest SCK frequency the device accepts (F_CPU/2 ... F_CPU/128).
+     * @param mode      SPI mode 0-3 (CPOL, CPHA).
+     * @param lsbFirst  Bit order.
+     */
+    SpiDevice(uint8_t csPin, uint32_t clockHz, uint8_t mode = 0, bool lsbFirst = false);
+
+    /**
+     * @brief Starts the bus if needed, resolves the chip select and leaves it deselected.
+     *
+     * @return false if the pin does not exist.
+     */
+    bool begin();
+
+    /**
+     * @brief Loads the settings of this device into the SPI.
+     *
+     * @param interrupt  Enables the transfer-complete interrupt.
+     */
+    void apply(bool interrupt) const {
+        SPCR = control | (interrupt ? _BV(SPIE) : 0);
+        SPSR = status;
+    }
+
+    void select() const { *csOut &= ~csMask; }
+    void deselect() const { *csOut |= csMask; }
+
+private:
+    uint8_t csPin;
+    uint8_t control;            // SPCR without SPIE
+    uint8_t status;             // SPSR (SPI2X)
+    volatile uint8_t* csOut;
+    uint8_t csMask;
+};
+
+struct SpiTransfer;
+
+/**
+ * @brief Completion callback, called from the SPI interrupt once the next transfer has started.
+ */
+typedef void (*SpiCallback)(SpiTransfer& transfer);
+
+/**
+ * @brief One transfer. Owned by the driver; untouched while queued or busy.
+ */
+struct SpiTransfer {
+    SpiDevice* device;
+    const uint8_t* txData;      // nullptr: SPI_FILL_BYTE is sent
+    uint8_t* rxData;            // nullptr: received bytes are discarded
+    uint8_t length;             // 1..255
+    SpiCallback done;           // nullptr: poll `status` instead
+    void* context;              // For the callback
+    volatile SpiStatus status;
+};
+
+/**
+ * @brief True when the transfer is not queued or running (it may be submitted again).
+ */
+inline bool spiFinished(const SpiTransfer& transfer) {
+    return transfer.status == SPI_DONE || transfer.status == SPI_IDLE;
+}
+
+#if FEATURE_SPI_BUS
+
+/**
+ * @brief Configures MOSI, SCK and SS as outputs and MISO as input (once).
+ */
+void spiBegin();
+
+/**
+ * @brief Queues a transfer. Safe from a completion callback.
+ *
+ * @return false if it is still pending, the queue is full or it is invalid.
+ */
+bool spiSubmit(SpiTransfer& transfer);
+
+/**
+ * @brief True while a transfer is queued or on the bus.
+ */
+bool spiBusy();
+
+/**
+ * @brief Sends up to SPI_BURST_BYTES now, polling, if the bus is free.
+ *
+ * @param tx  Bytes to send (nullptr: SPI_FILL_BYTE).
+ * @param rx  Received bytes (nullptr: discarded).
+ * @return false if the bus is busy or the length is out of range.
+ */
+bool spiTransferBurst(const SpiDevice& device, const uint8_t* tx, uint8_t* rx, uint8_t length);
+
+#else
+
+inline void spiBegin() {}
+inline bool spiSubmit(SpiTransfer&) { return false; }
+inline bool spiBusy() { return false; }
+inline bool spiTransferBurst(const SpiDevice&, const uint8_t*, uint8_t*, uint8_t) { return false; }
+
+#endif // FEATURE_SPI_BUS
+
+#endif // SPI_BUS_H
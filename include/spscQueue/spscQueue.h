@@ -0,0 +1,179 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <Arduino.h>
+
+/*
+ * 📨 Lock-free single-producer single-consumer queues.
+ *
+ * The standard path for data leaving an interrupt: the ISR pushes, a task
+ * pops (or the other way round), and neither side disables interrupts.
+ *
+ * Indices are single bytes that run freely and are masked on access, so
+ * every index load/store is atomic on AVR and `head - tail` is the fill level.
+ * The producer only writes `head`, the consumer only writes `tail`; the
+ * element is written (read) before the index that publishes (releases) it.
+ *
+ * A push on a full queue is dropped and counted as an overrun. Every queue
+ * registers itself for `showQueueReport()`, like the static pools.
+ */
+
+// Compiler barrier: element accesses are not moved across index updates
+#define SPSC_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+/**
+ * @brief Common part of every queue: name, geometry and statistics.
+ */
+class QueueBase {
+public:
+    /**
+     * @brief Constructor of the QueueBase class. Registers the queue in the report list.
+     *
+     * @param name         Name of the module that owns the queue.
+     * @param elementSize  Size of one element in bytes.
+     * @param capacity     Number of elements.
+     */
+    QueueBase(const char* name, uint8_t elementSize, uint8_t capacity);
+
+    const char* name() const { return queueName; }
+    uint8_t elementSize() const { return elementBytes; }
+    uint8_t capacity() const { return elementCount; }
+    uint8_t size() const { return (uint8_t)(head - tail); }
+    bool empty() const { return head == tail; }
+
+    /**
+     * @brief Highest fill level seen by the producer.
+     */
+    uint8_t highWater() const { return maxFill; }
+
+    /**
+     * @brief Pushes dropped because the queue was full (read atomically).
+     */
+    uint16_t overruns() const;
+
+    /**
+     * @brief Clears the overrun counter and the high-water mark.
+     */
+    void resetStats();
+
+    /**
+     * @brief First registered queue (iterate with `next()`).
+     */
+    static const QueueBase* first() { return headQueue; }
+    const QueueBase* next() const { return nextQueue; }
+
+protected:
+    volatile uint8_t head;      // Written by the producer only
+    volatile uint8_t tail;      // Written by the consumer only
+    volatile uint16_t overrunCount;
+    volatile uint8_t maxFill;
+
+private:
+    const char* queueName;
+    uint8_t elementBytes;
+    uint8_t elementCount;
+    const QueueBase* nextQueue;
+
+    static const QueueBase* headQueue;
+};
+
+/**
+ * @brief SPSC ring buffer with storage reserved at compile time.
+ *
+ * @tparam T  Element type (copied by assignment; keep it small).
+ * @tparam N  Capacity: power of two, 2..128.
+ */
+template <typename T, uint8_t N>
+class SpscQueue : public QueueBase {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Queue capacity must be a power of two");
+    static_assert(N <= 128, "Fill level must fit in a free-running 8-bit index");
+    static_assert(sizeof(T) <= 255, "Element too large for the queue report");
+
+public:
+    /**
+     * @brief Constructor of the SpscQueue class.
+     *
+     * @param name  Name of the module that owns the queue (shown in the report).
+     */
+    explicit SpscQueue(const char* name) : QueueBase(name, sizeof(T), N) {}
+
+    /**
+     * @brief Producer side: appends one element.
+     *
+     * @return false if the queue was full (the element is dropped and counted).
+     */
+    bool push(const T& item) {
+        const uint8_t h = head;
+        const uint8_t fill = (uint8_t)(h - tail);
+        if (fill >= N) {
+            overrunCount = overrunCount + 1;
+            return false;
+        }
+        items[h & (N - 1)] = item;
+        SPSC_BARRIER();
+        head = h + 1;
+        if (fill + 1 > maxFill) {
+            maxFill = fill + 1;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: removes the oldest element.
+     *
+     * @return false if the queue was empty.
+     */
+    bool pop(T& item) {
+        const uint8_t t = tail;
+        if (head == t) {
+            return false;
+        }
+        item = items[t & (N - 1)];
+        SPSC_BARRIER();
+        tail = t + 1;
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: removes up to `maxCount` elements in one go.
+     *
+     * The fill level is read once and the tail is published once, so a batch
+     * costs one index update whatever its size.
+     *
+     * @return Number of elements copied to `out`.
+     */
+    uint8_t pop(T* out, uint8_t maxCount) {
+        const uint8_t t = tail;
+        uint8_t count = (uint8_t)(head - t);
+        if (count > maxCount) {
+            count = maxCount;
+        }
+        for (uint8_t i = 0; i < count; ++i) {
+            out[i] = items[(uint8_t)(t + i) & (N - 1)];
+        }
+        SPSC_BARRIER();
+        tail = t + count;
+        return count;
+    }
+
+    /**
+     * @brief Consumer side: oldest element without removing it.
+     *
+     * @return false if the queue was empty.
+     */
+    bool peek(T& item) const {
+        const uint8_t t = tail;
+        if (head == t) {
+            return false;
+        }
+        item = items[t & (N - 1)];
+        return true;
+    }
+
+    bool full() const { return size() >= N; }
+
+private:
+    T items[N];
+};
+
+#endif // SPSC_QUEUE_H
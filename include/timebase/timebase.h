@@ -0,0 +1,151 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+
+/*
+ * ⏱️ High-resolution timebase on Timer5.
+ *
+ * Timer5 runs free at clk/1 (62.5 ns per tick) and its overflow ISR counts
+ * the high 16 bits, so `timebaseNow()` returns a 32-bit tick count that wraps
+ * every 268 s. The read is a few instructions with interrupts held off; an
+ * overflow still pending at that moment is resolved from TOV5.
+ *
+ * Edges on ICP5 (pin 48) are latched in hardware into ICR5, so their time does
+ * not depend on interrupt latency. The capture unit has one user at a time,
+ * in one of three modes:
+ *  - queue: the ISR timestamps every edge with the 32-bit count and pushes it
+ *    to an SpscQueue drained with `timebaseCapturePop()`;
+ *  - record: the ISR only stores ICR5 into the caller's buffer until it is
+ *    full (bit-stream decoders: DHT frames);
+ *  - claimed: no capture interrupt, the driver polls ICF5/ICR5 itself from
+ *    its own timing ISR (1-Wire slots).
+ *
+ * Timer5 is taken from the Arduino core (no analogWrite on pins 44-46), and
+ * while it runs its interrupts keep the power manager out of POWER_DOWN:
+ * drivers start it when they need it.
+ */
+
+// Ticks per microsecond (clk/1 at 16 MHz)
+constexpr uint8_t TIMEBASE_TICKS_PER_US = 16;
+
+// Input capture pin (ICP5 = PL1)
+constexpr uint8_t TIMEBASE_CAPTURE_PIN = 48;
+
+/**
+ * @brief Edges timestamped by the input capture unit.
+ */
+enum CaptureEdge : uint8_t {
+    CAPTURE_RISING,
+    CAPTURE_FALLING,
+    CAPTURE_BOTH       // Alternates the edge after every capture (pulse widths)
+};
+
+/**
+ * @brief One timestamped edge.
+ */
+struct TimebaseCapture {
+    uint32_t ticks;
+    bool rising;
+};
+
+/**
+ * @brief Converts a tick interval to microseconds.
+ */
+inline uint32_t timebaseTicksToMicros(uint32_t ticks) {
+    return ticks / TIMEBASE_TICKS_PER_US;
+}
+
+#if FEATURE_TIMEBASE
+
+// High 16 bits of the count, written by TIMER5_OVF_vect (use timebaseNow())
+extern volatile uint16_t timebaseOverflows;
+
+/**
+ * @brief Takes Timer5 from the core and starts it free-running at clk/1 (once; later calls do nothing).
+ */
+void timebaseBegin();
+
+/**
+ * @brief Current 32-bit tick count, race-free against the overflow ISR.
+ */
+inline uint32_t timebaseNow() {
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint16_t low = TCNT5;
+    uint16_t high = timebaseOverflows;
+    // Wrapped after the last ISR ran: the low half already restarted from 0
+    if ((TIFR5 & _BV(TOV5)) && low < 0x8000) {
+        ++high;
+    }
+    SREG = oldSREG;
+    return ((uint32_t)high << 16) | low;
+}
+
+/**
+ * @brief Ticks elapsed since `start` (a previous `timebaseNow()`).
+ */
+inline uint32_t timebaseElapsed(uint32_t start) {
+    return timebaseNow() - start;
+}
+
+/**
+ * @brief Starts timestamping edges on ICP5 (queue mode). Starts the timebase if needed.
+ *
+ * @param edge           Edge(s) to capture.
+ * @param noiseCanceler  Requires 4 equal samples before an edge is accepted (+250 ns delay).
+ * @return false if the capture unit is in use.
+ */
+bool timebaseCaptureBegin(CaptureEdge edge, bool noiseCanceler);
+
+/**
+ * @brief Stores ICR5 of the next `length` edges into `buffer`, then stops capturing (record mode).
+ *
+ * The pin is left as configured by the caller. Intervals under 4 ms are the
+ * uint16_t difference of consecutive entries; check progress with
+ * `timebaseCaptureCount()` and stop early with `timebaseCaptureEnd()`.
+ *
+ * @return false if the capture unit is in use or `length` is 0.
+ */
+bool timebaseCaptureRecord(volatile uint16_t* buffer, uint8_t length, CaptureEdge edge, bool noiseCanceler);
+
+/**
+ * @brief Entries stored so far in record mode.
+ */
+uint8_t timebaseCaptureCount();
+
+/**
+ * @brief Takes the capture unit without its interrupt (claimed mode): the caller reads ICF5/ICR5.
+ *
+ * @return false if the capture unit is in use.
+ */
+bool timebaseCaptureClaim(CaptureEdge edge, bool noiseCanceler);
+
+/**
+ * @brief Stops capturing and frees the capture unit (the timebase keeps running).
+ */
+void timebaseCaptureEnd();
+
+/**
+ * @brief Oldest captured edge not yet read.
+ *
+ * @return false if no edge is waiting.
+ */
+bool timebaseCapturePop(TimebaseCapture& capture);
+
+#else
+
+inline void timebaseBegin() {}
+inline uint32_t timebaseNow() { return 0; }
+inline uint32_t timebaseElapsed(uint32_t) { return 0; }
+inline bool timebaseCaptureBegin(CaptureEdge, bool) { return false; }
+inline bool timebaseCaptureRecord(volatile uint16_t*, uint8_t, CaptureEdge, bool) { return false; }
+inline uint8_t timebaseCaptureCount() { return 0; }
+inline bool timebaseCaptureClaim(CaptureEdge, bool) { return false; }
+inline void timebaseCaptureEnd() {}
+inline bool timebaseCapturePop(TimebaseCapture&) { return false; }
+
+#endif // FEATURE_TIMEBASE
+
+#endif // TIMEBASE_H
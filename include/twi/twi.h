@@ -0,0 +1,134 @@
+#ifndef TWI_H
+#define TWI_H
+
+#include <Arduino.h>
+#include "buildConfig.h"
+
+/*
+ * 🔧 Interrupt-driven I2C (TWI) master on SDA/SCL (pins 20/21, Pins::I2C).
+ *
+ * Drivers describe each transfer in a `TwiTransaction` they own and queue it
+ * with `twiSubmit()`; the TWI ISR runs the transactions back to back:
+ *
+ *   START, SLA+W, write bytes  [repeated START, SLA+R, read bytes]  STOP
+ *
+ * (write only, read only, or write-then-read with a repeated start; both
+ * lengths 0 probes the address). The CPU only spends the ISR per byte.
+ *
+ * A service task, armed while there is work, calls the completion callbacks
+ * (task context, in completion order) and watches the bus: a transaction that
+ * makes no progress for TWI_TIMEOUT_MS (slave holding SDA or stretching SCL
+ * forever) is failed with TWI_TIMEOUT and the bus is recovered by clocking SCL
+ * until SDA is released and sending a STOP.
+ *
+ * The engine owns TWI_vect: do not link the Wire library alongside.
+ */
+
+// Default SCL frequency; twiSetFrequency() accepts up to 400 kHz
+constexpr uint32_t TWI_DEFAULT_HZ = 100000;
+
+// No interrupt for this long during a transaction = bus hang
+constexpr uint8_t TWI_TIMEOUT_MS = 25;
+
+// Transactions waiting for the bus
+constexpr uint8_t TWI_QUEUE_LENGTH = 8;
+
+/**
+ * @brief State and result of a transaction.
+ */
+enum TwiStatus : uint8_t {
+    TWI_IDLE = 0,          // Never submitted
+    TWI_QUEUED,            // Waiting for the bus
+    TWI_BUSY,              // On the bus
+    TWI_OK,                // First final state (see twiFinished)
+    TWI_NACK_ADDRESS,      // No device answered
+    TWI_NACK_DATA,         // The device refused a written byte
+    TWI_ARBITRATION_LOST,
+    TWI_BUS_ERROR,         // Illegal START/STOP seen on the bus
+    TWI_TIMEOUT            // Bus hang; the bus was recovered
+};
+
+struct TwiTransaction;
+
+/**
+ * @brief Completion callback, called from the service task.
+ */
+typedef void (*TwiCallback)(TwiTransaction& transaction);
+
+/**
+ * @brief One transaction. Owned by the driver; untouched while queued or busy.
+ */
+struct TwiTransaction {
+    uint8_t address;              // 7-bit address
+    const uint8_t* writeData;
+    uint8_t writeLength;
+    uint8_t* readData;
+    uint8_t readLength;
+    TwiCallback done;             // nullptr: poll `status` instead
+    void* context;                // For the callback
+    volatile TwiStatus status;
+};
+
+/**
+ * @brief Engine counters since boot.
+ */
+struct TwiStats {
+    uint32_t completed;   // TWI_OK
+    uint16_t nacks;       // Address or data
+    uint16_t busErrors;   // Bus errors and lost arbitration
+    uint16_t timeouts;    // Each one followed by a bus recovery
+};
+
+/**
+ * @brief True when the transaction has a result (it may be submitted again).
+ */
+inline bool twiFinished(const TwiTransaction& transaction) {
+    return transaction.status >= TWI_OK || transaction.status == TWI_IDLE;
+}
+
+#if FEATURE_TWI
+
+/**
+ * @brief Enables the TWI at TWI_DEFAULT_HZ, releasing a stuck bus first.
+ */
+void twiBegin();
+
+/**
+ * @brief Sets the SCL frequency (31 kHz - 400 kHz); takes effect on the next byte.
+ */
+void twiSetFrequency(uint32_t hz);
+
+/**
+ * @brief Queues a transaction.
+ *
+ * @return false if it is still pending, the queue is full or the lengths are invalid.
+ */
+bool twiSubmit(TwiTransaction& transaction);
+
+/**
+ * @brief True while a transaction is queued or on the bus.
+ */
+bool twiBusy();
+
+/**
+ * @brief Copy of the counters (taken atomically).
+ */
+TwiStats twiStats();
+
+/**
+ * @brief Shell command: `twi` prints the counters, `twi scan` probes every address.
+ *
+ * @return true when finished (the scan takes several polls).
+ */
+bool twiCommand(const char* args);
+
+#else
+
+inline void twiBegin() {}
+inline void twiSetFrequency(uint32_t) {}
+inline bool twiSubmit(TwiTransaction&) { return false; }
+inline bool twiBusy() { return false; }
+
+#endif // FEATURE_TWI
+
+#endif // TWI_H
@@ -0,0 +1,100 @@
+#ifndef WS2812_H
+#define WS2812_H
+
+#include <Arduino.h>
+
+/**
+ * @brief WS2812 / NeoPixel driver for up to four strips on pins of the same port.
+ *
+ * Every strip is a lane of the driver. All lanes are clocked out at the same time
+ * by a hand-timed AVR assembly loop for 16 MHz (20 cycles per bit, 1.25 µs), so a
+ * frame with four lanes takes the same time as a frame with one.
+ *
+ * The frame buffer is owned by the caller (no heap) and stores 3 bytes per LED in
+ * the wire order G, R, B, interleaved by lane:
+ *
+ *   buffer[(led * 3 + colour) * numLanes + lane]
+ *
+ * Interrupts stay disabled while a frame is sent; the time of the last frame is
+ * available through `lastIrqOffMicros()` / `maxIrqOffMicros()`. A frame costs
+ * about 34 µs per LED, independent of the number of lanes; frames longer than
+ * 1 ms make `millis()` fall behind because Timer0 overflows are missed.
+ *
+ * @note Only pins on the I/O mapped ports (A to G) are supported: on the Mega
+ *       these are the GPIO pins 22 to 41. Port L (pins 42 to 49) needs `sts`,
+ *       which does not fit the bit timing.
+ */
+class Ws2812 {
+public:
+    static constexpr uint8_t MAX_LANES = 4;  // Strips sent in parallel
+
+    /**
+     * @brief Size in bytes of the frame buffer needed for a strip layout.
+     *
+     * @param numLeds   LEDs per strip.
+     * @param numLanes  Number of strips.
+     */
+    static constexpr size_t bufferSize(uint16_t numLeds, uint8_t numLanes) {
+        return (size_t)numLeds * 3 * numLanes;
+    }
+
+    /**
+     * @brief Constructor of the Ws2812 class.
+     *
+     * @param buffer    Frame buffer of `bufferSize(numLeds, numLanes)` bytes.
+     * @param numLeds   LEDs per strip.
+     * @param pins      Array with the data pin of each strip (same port).
+     * @param numLanes  Number of strips (1..MAX_LANES).
+     */
+    Ws2812(uint8_t* buffer, uint16_t numLeds, const uint8_t* pins, uint8_t numLanes);
+
+    /**
+     * @brief Configures the data pins as outputs (LOW) and clears the buffer.
+     *
+     * @return true if the pin layout is supported.
+     */
+    bool begin();
+
+    /**
+     * @brief Sets the colour of one LED in the frame buffer. Visible after `show()`.
+     */
+    void setPixel(uint8_t lane, uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
+
+    /**
+     * @brief Switches every LED of every strip off in the frame buffer.
+     */
+    void clear();
+
+    /**
+     * @brief Sends the frame buffer to all strips.
+     *
+     * Waits for the latch time of the previous frame (300 µs) if needed.
+     */
+    void show();
+
+    /**
+     * @brief Time interrupts were disabled while sending the last frame, in µs.
+     */
+    uint16_t lastIrqOffMicros() const { return irqOffMicros; }
+
+    /**
+     * @brief Longest time interrupts were disabled by a frame, in µs.
+     */
+    uint16_t maxIrqOffMicros() const { return irqOffMaxMicros; }
+
+private:
+    uint8_t* buffer;
+    uint16_t numLeds;
+    uint8_t numLanes;
+    uint8_t pins[MAX_LANES];
+    uint8_t laneMask[MAX_LANES];  // Port bit of each lane (0 for unused lanes)
+    uint8_t portMask;             // Port bits of all lanes
+    volatile uint8_t* port;       // PORTx register shared by the lanes
+    bool valid;
+
+    uint32_t lastShowMicros;      // End of the last frame, for the latch time
+    uint16_t irqOffMicros;
+    uint16_t irqOffMaxMicros;
+};
+
+#endif // WS2812_H
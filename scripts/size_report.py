@@ -0,0 +1,62 @@
+"""
+Post-build size report for PlatformIO.
+
+After linking, reads the section sizes of firmware.elf with avr-size and prints
+the flash (.text + .data) and SRAM (.data + .bss + .noinit) used by the image.
+The figures are stored in the build directory as size_report.json.
+
+Environments that set `custom_size_reference` compare themselves with the
+report of that environment and print the flash/SRAM saved by the feature
+named in `custom_size_feature`. Build the reference environment first, e.g.:
+
+    pio run -e mega_static_full -e mega_static_no_ws2812
+"""
+
+import json
+import os
+import subprocess
+
+Import("env")  # noqa: F821 (provided by PlatformIO/SCons)
+
+
+def read_sections(elf_path):
+    output = subprocess.check_output([env.subst("$SIZETOOL"), "-A", elf_path]).decode()
+    sections = {}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sections[parts[0]] = int(parts[1])
+    return {
+        "flash": sections.get(".text", 0) + sections.get(".data", 0),
+        "sram": sections.get(".data", 0) + sections.get(".bss", 0) + sections.get(".noinit", 0),
+    }
+
+
+def size_report(source, target, env):
+    build_dir = env.subst("$BUILD_DIR")
+    name = env.subst("$PIOENV")
+    sizes = read_sections(str(target[0]))
+
+    with open(os.path.join(build_dir, "size_report.json"), "w") as handle:
+        json.dump(sizes, handle)
+
+    print("Size report [%s]: flash %d B, SRAM %d B" % (name, sizes["flash"], sizes["sram"]))
+
+    reference = env.GetProjectOption("custom_size_reference", "")
+    if not reference:
+        return
+
+    reference_file = os.path.join(os.path.dirname(build_dir), reference, "size_report.json")
+    if not os.path.isfile(reference_file):
+        print("Size report [%s]: build '%s' first to compare" % (name, reference))
+        return
+
+    with open(reference_file) as handle:
+        base = json.load(handle)
+
+    feature = env.GetProjectOption("custom_size_feature", name)
+    print("Size report [%s]: '%s' disabled saves flash %d B, SRAM %d B (vs %s)" % (
+        name, feature, base["flash"] - sizes["flash"], base["sram"] - sizes["sram"], reference))
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", size_report)
@@ -47,6 +47,15 @@ void LedBasicoDigital::conmutacionEstado() {
     digitalWrite(pin, !digitalRead(pin));
 }
 
+/**
+ * @brief Devuelve el estado actual del LED.
+ * 
+ * Lee el registro de salida del pin.
+ */
+bool LedBasicoDigital::estado() const {
+    return digitalRead(pin) == HIGH;
+}
+
 void LedBasicoDigital::conmutacionEstadoPorTiempo(unsigned long tiempoAlternacia) {
     static unsigned long lastToggleTime = 0;
 
@@ -0,0 +1,332 @@
+#include "buildConfig.h"
+
+#if FEATURE_BENCHMARK
+
+#include "benchmark/benchmark.h"
+#include "profiler/profiler.h"
+#include "msg/msg.h"
+#include "dsp/filters.h"
+#include "dsp/fixed.h"
+#include "pinout/pinout.h"
+#include "spiBus/spiBus.h"
+#include "encoder/encoder.h"
+#include <SPI.h>
+
+constexpr uint8_t BENCH_CYCLES_PER_TICK = F_CPU / 1000000UL / PROFILER_TICKS_PER_US;
+
+typedef void (*BenchBody)();
+
+/**
+ * @brief Entry of the benchmark table (lives in PROGMEM).
+ */
+struct BenchEntry {
+    const char* name;   // PROGMEM string
+    BenchBody body;
+    bool rate;          // ISR entries: also print the edge rate
+};
+
+// Inputs and outputs go through volatiles so nothing is folded away
+static volatile int16_t benchInput = 1234;
+static volatile int16_t benchSink;
+static volatile int16_t benchDivisor = 300;
+static volatile float benchFloatInput = 4.82f;
+static volatile float benchFloatDivisor = 1.17f;
+static volatile float benchFloatSink;
+
+typedef Fixed<7, 8> BenchFixed;
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Bodies
+
+static void benchBaseline() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = benchInput + i;
+    }
+}
+
+template <typename Filter>
+static void benchFilter(Filter& filter) {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = filter.update(benchInput + i);
+    }
+}
+
+static void benchMovingAverage8() {
+    static MovingAverage<int16_t, 8> filter;
+    benchFilter(filter);
+}
+
+static void benchMovingAverage32() {
+    static MovingAverage<int16_t, 32> filter;
+    benchFilter(filter);
+}
+
+static void benchMedian3() {
+    static MedianFilter<int16_t, 3> filter;
+    benchFilter(filter);
+}
+
+static void benchMedian5() {
+    static MedianFilter<int16_t, 5> filter;
+    benchFilter(filter);
+}
+
+static void benchMedian7() {
+    static MedianFilter<int16_t, 7> filter;
+    benchFilter(filter);
+}
+
+static void benchMedian9() {
+    static MedianFilter<int16_t, 9> filter;
+    benchFilter(filter);
+}
+
+static void benchExp4() {
+    static ExpFilter<int16_t, 4> filter;
+    benchFilter(filter);
+}
+
+// Butterworth low-pass, fc = fs / 20
+static constexpr BiquadCoefficients lowPass = biquadCoefficients(0.02008, 0.04017, 0.02008, -1.56102, 0.64135, 1);
+
+static void benchBiquad() {
+    static BiquadQ15<1> filter(lowPass);
+    benchFilter(filter);
+}
+
+// Fixed<7, 8> against float: the same operation on comparable operands
+
+static void benchFixedAdd() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = (BenchFixed::fromRaw(benchInput) + BenchFixed::fromRaw(i)).raw();
+    }
+}
+
+static void benchFloatAdd() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchFloatSink = benchFloatInput + i;
+    }
+}
+
+static void benchFixedMul() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = (BenchFixed::fromRaw(benchInput) * BenchFixed::fromRaw(benchDivisor + i)).raw();
+    }
+}
+
+static void benchFloatMul() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchFloatSink = benchFloatInput * (benchFloatDivisor + i);
+    }
+}
+
+static void benchFixedDiv() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = (BenchFixed::fromRaw(benchInput) / BenchFixed::fromRaw(benchDivisor + i)).raw();
+    }
+}
+
+static void benchFloatDiv() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchFloatSink = benchFloatInput / (benchFloatDivisor + i);
+    }
+}
+
+// ADC counts to millivolts (5 V reference)
+
+static void benchScaleRatio() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = fixedScale<RatioAdcToMillivolts5V>(benchInput + i);
+    }
+}
+
+static void benchScaleDivide() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = (uint32_t)(uint16_t)(benchInput + i) * 5000UL / 1023;
+    }
+}
+
+static void benchScaleFloat() {
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        benchSink = (uint16_t)(benchInput + i) * (5000.0f / 1023.0f);
+    }
+}
+
+#if FEATURE_SPI_BUS
+// 8-byte transfers at 8 MHz to a dummy device selected on BENCH_SPI_CS_PIN
+// (the bytes also enter a shift register chain, which is not latched)
+constexpr uint8_t BENCH_SPI_BYTES = 8;
+constexpr uint32_t BENCH_SPI_HZ = 8000000UL;
+
+static SpiDevice benchDevice(BENCH_SPI_CS_PIN, BENCH_SPI_HZ, 0);
+static uint8_t benchSpiData[BENCH_SPI_BYTES];
+static bool benchDeviceReady = false;
+
+/**
+ * @brief Lets pending bus traffic finish; sets up the dummy device on first use.
+ */
+static void benchSpiPrepare() {
+    if (!benchDeviceReady) {
+        benchDeviceReady = benchDevice.begin();
+        pinClaim(BENCH_SPI_CS_PIN);
+    }
+    while (spiBusy()) {
+    }
+}
+
+static void benchSpiQueued() {
+    static SpiTransfer transfer;
+    transfer.device = &benchDevice;
+    transfer.txData = benchSpiData;
+    transfer.rxData = benchSpiData;
+    transfer.length = BENCH_SPI_BYTES;
+    benchSpiPrepare();
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        spiSubmit(transfer);
+        while (!spiFinished(transfer)) {
+        }
+    }
+}
+
+static void benchSpiBurst() {
+    benchSpiPrepare();
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        spiTransferBurst(benchDevice, benchSpiData, benchSpiData, BENCH_SPI_BYTES);
+    }
+}
+
+/**
+ * @brief The SPI library path; SPCR/SPSR are restored so the engine finds them as it left them.
+ */
+static void benchSpiArduino() {
+    benchSpiPrepare();
+    const uint8_t spcr = SPCR;
+    const uint8_t spsr = SPSR;
+    for (uint8_t i = 0; i < BENCH_BATCH; ++i) {
+        SPI.beginTransaction(SPISettings(BENCH_SPI_HZ, MSBFIRST, SPI_MODE0));
+        digitalWrite(BENCH_SPI_CS_PIN, LOW);
+        for (uint8_t b = 0; b < BENCH_SPI_BYTES; ++b) {
+            benchSpiData[b] = SPI.transfer(benchSpiData[b]);
+        }
+        digitalWrite(BENCH_SPI_CS_PIN, HIGH);
+        SPI.endTransaction();
+    }
+    SPCR = spcr;
+    SPSR = spsr;
+}
+#endif
+
+#if FEATURE_ENCODER
+// ISR bodies on scratch state, with interrupts off for the whole batch
+static void benchEncoderEdge() {
+    encoderBenchEdges(BENCH_BATCH);
+}
+
+static void benchCounterEdge() {
+    pulseCounterBenchEdges(BENCH_BATCH);
+}
+#endif
+
+#define BENCH_STRING(id, text) static const char id[] PROGMEM = text;
+BENCH_STRING(movingAverage8Name, "movingAverage<int16,8>")
+BENCH_STRING(movingAverage32Name, "movingAverage<int16,32>")
+BENCH_STRING(median3Name, "median<int16,3>")
+BENCH_STRING(median5Name, "median<int16,5>")
+BENCH_STRING(median7Name, "median<int16,7>")
+BENCH_STRING(median9Name, "median<int16,9>")
+BENCH_STRING(exp4Name, "exp<int16,4>")
+BENCH_STRING(biquadName, "biquadQ15")
+BENCH_STRING(fixedAddName, "fixed<7,8> add")
+BENCH_STRING(floatAddName, "float add")
+BENCH_STRING(fixedMulName, "fixed<7,8> mul")
+BENCH_STRING(floatMulName, "float mul")
+BENCH_STRING(fixedDivName, "fixed<7,8> div")
+BENCH_STRING(floatDivName, "float div")
+BENCH_STRING(scaleRatioName, "adc->mV ratio")
+BENCH_STRING(scaleDivideName, "adc->mV uint32 div")
+BENCH_STRING(scaleFloatName, "adc->mV float")
+BENCH_STRING(spiQueuedName, "spi 8B queued (ISR)")
+BENCH_STRING(spiBurstName, "spi 8B burst")
+BENCH_STRING(spiArduinoName, "spi 8B SPI.transfer")
+BENCH_STRING(encoderEdgeName, "encoder edge (ISR body)")
+BENCH_STRING(counterEdgeName, "counter edge (ISR body)")
+#undef BENCH_STRING
+
+static const BenchEntry entries[] PROGMEM = {
+    {movingAverage8Name, benchMovingAverage8, false},
+    {movingAverage32Name, benchMovingAverage32, false},
+    {median3Name, benchMedian3, false},
+    {median5Name, benchMedian5, false},
+    {median7Name, benchMedian7, false},
+    {median9Name, benchMedian9, false},
+    {exp4Name, benchExp4, false},
+    {biquadName, benchBiquad, false},
+    {fixedAddName, benchFixedAdd, false},
+    {floatAddName, benchFloatAdd, false},
+    {fixedMulName, benchFixedMul, false},
+    {floatMulName, benchFloatMul, false},
+    {fixedDivName, benchFixedDiv, false},
+    {floatDivName, benchFloatDiv, false},
+    {scaleRatioName, benchScaleRatio, false},
+    {scaleDivideName, benchScaleDivide, false},
+    {scaleFloatName, benchScaleFloat, false},
+#if FEATURE_SPI_BUS
+    {spiQueuedName, benchSpiQueued, false},
+    {spiBurstName, benchSpiBurst, false},
+    {spiArduinoName, benchSpiArduino, false},
+#endif
+#if FEATURE_ENCODER && ENCODER_INT_LINES
+    {encoderEdgeName, benchEncoderEdge, true},
+#endif
+#if FEATURE_ENCODER && COUNTER_INT_LINES
+    {counterEdgeName, benchCounterEdge, true},
+#endif
+};
+
+constexpr uint8_t entryCount = sizeof(entries) / sizeof(entries[0]);
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Runner
+
+static uint8_t nextEntry = 0;
+static uint32_t baselineCycles = 0;
+
+/**
+ * @brief Cycles of the fastest of BENCH_RUNS runs of `body`.
+ */
+static uint32_t measureCycles(BenchBody body) {
+    uint16_t best = 0xFFFF;
+    for (uint8_t run = 0; run < BENCH_RUNS; ++run) {
+        const uint16_t start = profilerNow();
+        body();
+        const uint16_t ticks = profilerNow() - start;
+        if (ticks < best) {
+            best = ticks;
+        }
+    }
+    return (uint32_t)best * BENCH_CYCLES_PER_TICK;
+}
+
+bool benchmarkStep() {
+    if (!serialOutputIdle()) {
+        return false;
+    }
+
+    if (nextEntry == 0) {
+        baselineCycles = measureCycles(benchBaseline);
+    }
+
+    const BenchBody body = (BenchBody)pgm_read_ptr(&entries[nextEntry].body);
+    const uint32_t cycles = measureCycles(body);
+    const uint32_t net = cycles > baselineCycles ? cycles - baselineCycles : 0;
+    showBenchmarkResult((const char*)pgm_read_ptr(&entries[nextEntry].name), net / BENCH_BATCH,
+                        pgm_read_byte(&entries[nextEntry].rate));
+
+    if (++nextEntry < entryCount) {
+        return false;
+    }
+    nextEntry = 0;
+    return true;
+}
+
+#endif // FEATURE_BENCHMARK
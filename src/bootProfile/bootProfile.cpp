@@ -0,0 +1,64 @@
+#include "bootProfile/bootProfile.h"
+#include "configuracion.h"
+#include "pinout/pinout.h"
+#include "msg/msg.h"
+#include "deviceRegistry/deviceRegistry.h"
+#include "coroutine/coroutine.h"
+
+static uint32_t phaseMicros[BOOT_PHASE_COUNT];
+
+static const char* const phaseNames[BOOT_PHASE_COUNT] = {
+    "config", "serial", "pins", "devices", "banner", "diag"
+};
+
+static Coroutine report;             // Deferred report, run by the bootReport device
+static bool reportFinished = false;
+
+void bootMark(BootPhase phase) {
+    if (phase < BOOT_PHASE_COUNT) {
+        phaseMicros[phase] = micros();
+    }
+}
+
+uint32_t bootPhaseMicros(BootPhase phase) {
+    return phase < BOOT_PHASE_COUNT ? phaseMicros[phase] : 0;
+}
+
+const char* bootPhaseName(BootPhase phase) {
+    return phase < BOOT_PHASE_COUNT ? phaseNames[phase] : "?";
+}
+
+bool bootReportPending() {
+    return systemConfiguration.fastBoot && !systemConfiguration.debugMode && !reportFinished;
+}
+
+void bootReportPoll() {
+    CORO_BEGIN(report);
+
+    CORO_WAIT_UNTIL(report, serialOutputIdle());
+    standardMessage("Sistema iniciado modo ejecucion (arranque rapido)", __FILE__, __FUNCTION__, __DATE__, __TIME__);
+
+    CORO_WAIT_UNTIL(report, serialOutputIdle());
+    showConfigurationMessage(systemConfiguration);
+
+    CORO_WAIT_UNTIL(report, serialOutputIdle());
+    showMemoryPoolReport();
+    bootMark(BOOT_BANNER);
+
+    // One pin action per call, the device period is the settle time: the
+    // yield keeps an idle UART from running "arm" and "read" back to back
+    do {
+        CORO_YIELD(report);
+        CORO_WAIT_UNTIL(report, serialOutputIdle());
+    } while (!backgroundDiagnosticsStep());
+    bootMark(BOOT_DIAGNOSTICS);
+
+    CORO_WAIT_UNTIL(report, serialOutputIdle());
+    showBootTimingMessage();
+
+    // The predicate is now false: the registry removes this task
+    reportFinished = true;
+    deviceRegistryBegin();
+
+    CORO_END(report);
+}
@@ -0,0 +1,191 @@
+#include "buildConfig.h"
+
+#if FEATURE_CONFIG_STORE
+
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <stddef.h>
+#include "configStore/configStore.h"
+#include "msg/msg.h"
+#include "deviceRegistry/deviceRegistry.h"
+
+/**
+ * @brief Layout of the configuration in EEPROM.
+ */
+struct ConfigBlob {
+    uint8_t version;            // CONFIG_BLOB_VERSION
+    uint8_t length;             // sizeof(configuracionMain)
+    configuracionMain data;
+    uint16_t crc;               // CRC-16 of every previous byte
+};
+
+/**
+ * @brief Field of configuracionMain that can be patched over serial.
+ */
+struct ConfigField {
+    const char* name;           // PROGMEM string
+    uint8_t offset;
+};
+
+static const char debugModeName[] PROGMEM = "debugMode";
+static const char proyectoLedName[] PROGMEM = "proyectoLed";
+static const char fastBootName[] PROGMEM = "fastBoot";
+static const char lowPowerName[] PROGMEM = "lowPower";
+
+static const ConfigField configFields[] PROGMEM = {
+    {debugModeName,   offsetof(configuracionMain, debugMode)},
+    {proyectoLedName, offsetof(configuracionMain, proyectoLed)},
+    {fastBootName,    offsetof(configuracionMain, fastBoot)},
+    {lowPowerName,    offsetof(configuracionMain, lowPower)}
+};
+
+// Longest field name plus terminator
+static constexpr uint8_t CONFIG_FIELD_NAME_SIZE = sizeof(proyectoLedName);
+
+static ConfigBlob pendingBlob;                          // Blob being written
+static uint8_t pendingIndex = sizeof(ConfigBlob);       // Next byte to compare/write
+
+/**
+ * @brief CRC-16 (0xA001) of the blob header and data.
+ */
+static uint16_t blobCrc(const ConfigBlob& blob) {
+    const uint8_t* bytes = (const uint8_t*)&blob;
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < offsetof(ConfigBlob, crc); ++i) {
+        crc = _crc16_update(crc, bytes[i]);
+    }
+    return crc;
+}
+
+bool loadConfiguration() {
+    ConfigBlob blob;
+    eeprom_read_block(&blob, (const void*)CONFIG_EEPROM_ADDRESS, sizeof(blob));
+
+    if (blob.version == CONFIG_BLOB_VERSION &&
+        blob.length == sizeof(configuracionMain) &&
+        blob.crc == blobCrc(blob)) {
+        systemConfiguration = blob.data;
+
+        // Debug mode lasts one boot: setup() never starts Serial in that mode,
+        // so the shell cannot turn it off. The stored copy is cleared through
+        // the incremental writer, which keeps running under configStorePoll()
+        if (blob.data.debugMode) {
+            pendingBlob = blob;
+            pendingBlob.data.debugMode = false;
+            pendingBlob.crc = blobCrc(pendingBlob);
+            pendingIndex = 0;
+        }
+        return true;
+    }
+
+    systemConfiguration = defaultConfiguration;
+    saveConfiguration();
+    return false;
+}
+
+void saveConfiguration() {
+    pendingBlob.version = CONFIG_BLOB_VERSION;
+    pendingBlob.length = sizeof(configuracionMain);
+    pendingBlob.data = systemConfiguration;
+    pendingBlob.crc = blobCrc(pendingBlob);
+    pendingIndex = 0;
+}
+
+/**
+ * @brief Advances the pending save without waiting for the EEPROM.
+ *
+ * Unchanged bytes are skipped (a read takes 4 cycles); at most one write is
+ * started per call, and only when the previous one has finished. The CRC is
+ * the last field of the blob, so an interrupted save is detected at boot.
+ */
+static void writePendingBytes() {
+    while (pendingIndex < sizeof(ConfigBlob)) {
+        if (!eeprom_is_ready()) {
+            return;
+        }
+
+        uint8_t* address = (uint8_t*)(CONFIG_EEPROM_ADDRESS + pendingIndex);
+        const uint8_t value = ((const uint8_t*)&pendingBlob)[pendingIndex];
+        ++pendingIndex;
+
+        if (eeprom_read_byte(address) != value) {
+            eeprom_write_byte(address, value);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Re-initializes the subsystems affected by a configuration change and saves it.
+ *
+ * @param previous  Configuration before the change.
+ */
+static void applyConfiguration(const configuracionMain& previous) {
+    initializeMainConfigurationPins(systemConfiguration);
+    deviceRegistryBegin();
+
+    if (previous.debugMode != systemConfiguration.debugMode ||
+        previous.fastBoot != systemConfiguration.fastBoot) {
+        standardMessage("debugMode/fastBoot se aplicaran en el proximo arranque (debugMode solo en ese)", __FILE__, __FUNCTION__, __DATE__, __TIME__);
+    }
+
+    saveConfiguration();
+}
+
+bool configCommand(const char* args) {
+    while (*args == ' ') {
+        ++args;
+    }
+
+    if (*args == '\0') {
+        return true;
+    }
+
+    const configuracionMain previous = systemConfiguration;
+
+    if (strcmp(args, "reset") == 0) {
+        systemConfiguration = defaultConfiguration;
+        applyConfiguration(previous);
+        return true;
+    }
+
+    const char* value = strchr(args, ' ');
+    if (value == nullptr) {
+        standardErrorMessage("Uso: cfg <campo> <0|1>", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+
+    const size_t nameLength = value - args;
+    char name[CONFIG_FIELD_NAME_SIZE];
+    if (nameLength >= sizeof(name)) {
+        standardErrorMessage("Campo de configuracion desconocido", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+    memcpy(name, args, nameLength);
+    name[nameLength] = '\0';
+
+    while (*value == ' ') {
+        ++value;
+    }
+    if ((value[0] != '0' && value[0] != '1') || value[1] != '\0') {
+        standardErrorMessage("El valor debe ser 0 o 1", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+
+    for (const auto& field : configFields) {
+        if (strcmp_P(name, (const char*)pgm_read_ptr(&field.name)) == 0) {
+            ((uint8_t*)&systemConfiguration)[pgm_read_byte(&field.offset)] = (value[0] == '1');
+            applyConfiguration(previous);
+            return true;
+        }
+    }
+
+    standardErrorMessage("Campo de configuracion desconocido", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+    return false;
+}
+
+void configStorePoll() {
+    writePendingBytes();
+}
+
+#endif // FEATURE_CONFIG_STORE
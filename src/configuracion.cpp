@@ -1,6 +1,13 @@
 #include "configuracion.h"
 #include "pinout/pinout.h"
 #include "sensors_Led/sensor_Led.h"
+#include "memoryPool/memoryPool.h"
+#include "deviceRegistry/deviceRegistry.h"
+#include "configStore/configStore.h"
+#include "bootProfile/bootProfile.h"
+#include "powerManager/powerManager.h"
+#include "dataBus/dataBus.h"
+#include "shell/shell.h"
 
 /**
  * @brief Main configuration structure for the project.
@@ -9,13 +16,27 @@
  * of the application, allowing features to be enabled or disabled
  * at compile-time or runtime.
  */
-configuracionMain systemConfiguration = {
+#if !CONFIG_STATIC
+const configuracionMain defaultConfiguration = {
     // Initialize debug mode
     .debugMode = false,
     // Sensors and systems
-    .proyectoLed = false 
+    .proyectoLed = false,
+    // Boot sequence
+    .fastBoot = false,
+    // Serial console always awake
+    .lowPower = false
 };
 
+// Replaced at boot by the copy stored in EEPROM when it is valid
+configuracionMain systemConfiguration = defaultConfiguration;
+#endif
+
+#if FEATURE_PROYECTO_LED
+// Driver pools: storage reserved at compile time, the heap is never used
+static StaticPool<LedRojo, 1> ledRojoPool("LedRojo");
+#endif
+
 /**
  * @brief Initializes hardware pins according to the provided configuration.
  *
@@ -23,21 +44,70 @@ configuracionMain systemConfiguration = {
  * required by the project. If `debugMode` is active, enables pins for
  * diagnostics/tracing; if `proyectoLed` is active, prepares pins for the LED subsystem.
  *
+ * May be called again after the configuration changes at runtime: subsystems
+ * enabled since the previous call are created and the ones disabled are released.
+ *
  * @param configuration  Structure with flags that determine which pins are configured.
  * @pre Call once during system startup, before using peripherals.
  * @post Pins are left in a safe and consistent state for the remainder of execution.
  */
 // Initialization
+#if FEATURE_PROYECTO_LED
 LedRojo* ledRojo = nullptr;
+#endif
 
 void initializeMainConfigurationPins(configuracionMain systemConfiguration) {
     // Project setup
-    if (systemConfiguration.proyectoLed) {
+#if FEATURE_PROYECTO_LED
+    if (systemConfiguration.proyectoLed && ledRojo == nullptr) {
         // Pins
-        ledRojo = new LedRojo(Pins::GPIO[1].number); // Assign GPIO pin 22 to the red LED
+        ledRojo = ledRojoPool.create(Pins::GPIO[1].number); // Assign GPIO pin 22 to the red LED
+    } else if (!systemConfiguration.proyectoLed && ledRojo != nullptr) {
+        // Release the LED subsystem after a configuration change
+        ledRojo->off();
+        ledRojoPool.destroy(ledRojo);
+        ledRojo = nullptr;
+    }
+#endif
+    // Serial console: always awake, or woken by the first character
+    powerConsoleLowPower(systemConfiguration.lowPower);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Registered devices: one row per sensor, actuator or service (see deviceRegistry.h)
+
+#if FEATURE_PROYECTO_LED
+static const char ledRojoName[] PROGMEM = "ledRojo";
+static bool ledRojoEnabled() { return systemConfiguration.proyectoLed; }
+static void ledRojoPoll() {
+    if (ledRojo != nullptr) {
+        ledRojo->conmutacionEstado();
+        busPublish<TOPIC_LED_ROJO>(ledRojo->estado());
     }
 }
+#endif
 
+#if FEATURE_CONFIG_STORE
+static const char configStoreName[] PROGMEM = "configStore";
+#endif
 
+static const char shellName[] PROGMEM = "shell";
+static const char bootReportName[] PROGMEM = "bootReport";
 
+const DeviceDescriptor deviceTable[] PROGMEM = {
+    // name, enabled, init, poll, periodMs, priority
+#if FEATURE_PROYECTO_LED
+    {ledRojoName, ledRojoEnabled, nullptr, ledRojoPoll, 2000, TASK_PRIORITY_HIGH},
+#endif
+#if FEATURE_CONFIG_STORE
+    {configStoreName, nullptr, nullptr, configStorePoll, 20, TASK_PRIORITY_NORMAL},
+#endif
+    // Polled every 10 ms: at 57600 baud (5.76 B/ms) the 64-byte receive buffer
+    // fills in 11 ms, so a pasted line is read before it overflows
+    {shellName, nullptr, shellBegin, shellPoll, 10, TASK_PRIORITY_NORMAL},
+    {bootReportName, bootReportPending, nullptr, bootReportPoll, 5, TASK_PRIORITY_LOW},
+    {nullptr, nullptr, nullptr, nullptr, 0, TASK_PRIORITY_LOW}  // End of table
+};
 
+const uint8_t deviceCount = sizeof(deviceTable) / sizeof(deviceTable[0]) - 1;
+static_assert(sizeof(deviceTable) / sizeof(deviceTable[0]) - 1 <= MAX_DEVICES, "deviceTable exceeds MAX_DEVICES");
@@ -0,0 +1,80 @@
+#include "dataBus/dataBus.h"
+#include "msg/msg.h"
+
+/**
+ * @brief One registered callback.
+ */
+struct BusSubscription {
+    BusHook hook;   // nullptr = free entry
+    TopicId topic;
+};
+
+static BusSubscription subscriptions[MAX_SUBSCRIBERS];
+static uint16_t sequences[TOPIC_COUNT];
+
+#define DATABUS_TOPIC_NAME(id, type, name) static const char id##_NAME[] PROGMEM = name;
+DATABUS_TOPICS(DATABUS_TOPIC_NAME)
+#undef DATABUS_TOPIC_NAME
+
+static const char* const topicNames[TOPIC_COUNT] PROGMEM = {
+#define DATABUS_TOPIC_NAME_PTR(id, type, name) id##_NAME,
+    DATABUS_TOPICS(DATABUS_TOPIC_NAME_PTR)
+#undef DATABUS_TOPIC_NAME_PTR
+};
+
+bool busAddSubscriber(TopicId topic, BusHook hook) {
+    if (topic >= TOPIC_COUNT || hook == nullptr) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < MAX_SUBSCRIBERS; ++i) {
+        if (subscriptions[i].hook == nullptr) {
+            subscriptions[i].topic = topic;
+            subscriptions[i].hook = hook;
+            return true;
+        }
+    }
+
+    standardErrorMessage("Tabla de suscripciones del bus llena", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+    return false;
+}
+
+void busRemoveSubscriber(TopicId topic, BusHook hook) {
+    for (uint8_t i = 0; i < MAX_SUBSCRIBERS; ++i) {
+        if (subscriptions[i].hook == hook && subscriptions[i].topic == topic) {
+            subscriptions[i].hook = nullptr;
+        }
+    }
+}
+
+void busNotify(TopicId topic, BusInvoker invoker, const void* sample) {
+    if (topic >= TOPIC_COUNT) {
+        return;
+    }
+
+    ++sequences[topic];
+    for (uint8_t i = 0; i < MAX_SUBSCRIBERS; ++i) {
+        const BusSubscription& subscription = subscriptions[i];
+        if (subscription.hook != nullptr && subscription.topic == topic) {
+            invoker(subscription.hook, sample);
+        }
+    }
+}
+
+uint16_t busSequence(TopicId topic) {
+    return topic < TOPIC_COUNT ? sequences[topic] : 0;
+}
+
+uint8_t busSubscriberCount(TopicId topic) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_SUBSCRIBERS; ++i) {
+        if (subscriptions[i].hook != nullptr && subscriptions[i].topic == topic) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+const char* busTopicName(TopicId topic) {
+    return topic < TOPIC_COUNT ? (const char*)pgm_read_ptr(&topicNames[topic]) : nullptr;
+}
@@ -0,0 +1,40 @@
+#include "deviceRegistry/deviceRegistry.h"
+#include "msg/msg.h"
+
+static uint8_t taskIds[MAX_DEVICES];        // Scheduler task of each device
+static bool enabledFlags[MAX_DEVICES];
+
+void deviceRegistryBegin() {
+    for (uint8_t id = 0; id < deviceCount && id < MAX_DEVICES; ++id) {
+        DevicePredicate enabled = (DevicePredicate)pgm_read_ptr(&deviceTable[id].enabled);
+        const bool isEnabled = (enabled == nullptr) || enabled();
+
+        if (isEnabled && !enabledFlags[id]) {
+            DeviceHook init = (DeviceHook)pgm_read_ptr(&deviceTable[id].init);
+            if (init != nullptr) {
+                init();
+            }
+
+            DeviceHook poll = (DeviceHook)pgm_read_ptr(&deviceTable[id].poll);
+            taskIds[id] = schedulerAddPeriodic(poll,
+                                               pgm_read_word(&deviceTable[id].periodMs),
+                                               (TaskPriority)pgm_read_byte(&deviceTable[id].priority));
+            if (taskIds[id] == INVALID_TASK) {
+                standardErrorMessage("Tabla de tareas llena, dispositivo sin tarea", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            }
+        } else if (!isEnabled && enabledFlags[id]) {
+            schedulerRemove(taskIds[id]);
+            taskIds[id] = INVALID_TASK;
+        }
+
+        enabledFlags[id] = isEnabled;
+    }
+}
+
+bool deviceEnabled(uint8_t id) {
+    return id < MAX_DEVICES && enabledFlags[id];
+}
+
+uint8_t deviceTaskId(uint8_t id) {
+    return deviceEnabled(id) ? taskIds[id] : INVALID_TASK;
+}
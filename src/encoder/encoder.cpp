@@ -0,0 +1,280 @@
+#include "buildConfig.h"
+
+#if FEATURE_ENCODER
+
+#include "encoder/encoder.h"
+#include "msg/msg.h"
+
+/**
+ * @brief State of one encoder, updated by the ISRs of its two lines.
+ */
+struct Quadrature {
+    volatile int32_t count;
+    volatile uint16_t skips;
+    uint8_t previous;        // Previous AB, already shifted left by 2
+};
+
+// Step for each (previous AB << 2 | current AB); A is bit 0 (the even line)
+static const int8_t QUADRATURE_STEPS[16] = {
+     0, +1, -1,  0,
+    -1,  0,  0, +1,
+    +1,  0,  0, -1,
+     0, -1, +1,  0
+};
+
+static Quadrature encoders[ENCODER_PAIRS];
+static volatile uint32_t pulses[EXT_INT_LINES];
+static uint8_t runningEncoders = 0;      // Bit n = encoder n started
+static uint8_t runningCounters = 0;      // Bit n = counter on INTn started
+
+/**
+ * @brief AB state of encoder `pair`: both pins are adjacent bits of one port.
+ */
+static inline uint8_t pairState(uint8_t pair) {
+    return pair == 0 ? (PIND & 0x03) : (pair == 1 ? ((PIND >> 2) & 0x03) : ((PINE >> 4) & 0x03));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// ISRs
+
+template <uint8_t PAIR>
+static inline void quadratureEdge(Quadrature& encoder) {
+    const uint8_t state = pairState(PAIR);
+    const uint8_t index = encoder.previous | state;
+    encoder.count += QUADRATURE_STEPS[index];
+    // Both channels changed: at least one edge was missed
+    if (((index >> 2) ^ state) == 0x03) {
+        encoder.skips = encoder.skips + 1;
+    }
+    encoder.previous = state << 2;
+}
+
+static inline void countPulse(volatile uint32_t& count) {
+    count = count + 1;
+}
+
+#if ENCODER_INT_LINES & 0x03
+ISR(INT0_vect) { quadratureEdge<0>(encoders[0]); }
+ISR(INT1_vect, ISR_ALIASOF(INT0_vect));
+#endif
+#if ENCODER_INT_LINES & 0x0C
+ISR(INT2_vect) { quadratureEdge<1>(encoders[1]); }
+ISR(INT3_vect, ISR_ALIASOF(INT2_vect));
+#endif
+#if ENCODER_INT_LINES & 0x30
+ISR(INT4_vect) { quadratureEdge<2>(encoders[2]); }
+ISR(INT5_vect, ISR_ALIASOF(INT4_vect));
+#endif
+
+#if COUNTER_INT_LINES & 0x01
+ISR(INT0_vect) { countPulse(pulses[0]); }
+#endif
+#if COUNTER_INT_LINES & 0x02
+ISR(INT1_vect) { countPulse(pulses[1]); }
+#endif
+#if COUNTER_INT_LINES & 0x04
+ISR(INT2_vect) { countPulse(pulses[2]); }
+#endif
+#if COUNTER_INT_LINES & 0x08
+ISR(INT3_vect) { countPulse(pulses[3]); }
+#endif
+#if COUNTER_INT_LINES & 0x10
+ISR(INT4_vect) { countPulse(pulses[4]); }
+#endif
+#if COUNTER_INT_LINES & 0x20
+ISR(INT5_vect) { countPulse(pulses[5]); }
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Encoders
+
+static bool encoderOwned(uint8_t pair) {
+    if (pair < ENCODER_PAIRS && (ENCODER_INT_LINES & (0x03 << (pair * 2)))) {
+        return true;
+    }
+    standardErrorMessage("El par de líneas no es de un encoder", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+    return false;
+}
+
+bool encoderBegin(uint8_t pair, bool pullUp) {
+    if (!encoderOwned(pair)) {
+        return false;
+    }
+
+    uint8_t oldSREG = SREG;
+    cli();
+    extIntEnable(pair * 2, EXT_INT_CHANGE, pullUp);
+    extIntEnable(pair * 2 + 1, EXT_INT_CHANGE, pullUp);
+    encoders[pair].count = 0;
+    encoders[pair].skips = 0;
+    encoders[pair].previous = pairState(pair) << 2;
+    runningEncoders |= _BV(pair);
+    SREG = oldSREG;
+    return true;
+}
+
+void encoderEnd(uint8_t pair) {
+    if (pair >= ENCODER_PAIRS) {
+        return;
+    }
+    extIntDisable(pair * 2);
+    extIntDisable(pair * 2 + 1);
+    runningEncoders &= ~_BV(pair);
+}
+
+int32_t encoderCount(uint8_t pair) {
+    if (pair >= ENCODER_PAIRS) {
+        return 0;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    const int32_t count = encoders[pair].count;
+    SREG = oldSREG;
+    return count;
+}
+
+void encoderWrite(uint8_t pair, int32_t count) {
+    if (pair >= ENCODER_PAIRS) {
+        return;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    encoders[pair].count = count;
+    SREG = oldSREG;
+}
+
+uint16_t encoderSkips(uint8_t pair) {
+    if (pair >= ENCODER_PAIRS) {
+        return 0;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint16_t skips = encoders[pair].skips;
+    SREG = oldSREG;
+    return skips;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Pulse counters
+
+bool pulseCounterBegin(uint8_t line, ExtIntSense edge, bool pullUp) {
+    if (line >= EXT_INT_LINES || !(COUNTER_INT_LINES & _BV(line)) || edge == EXT_INT_LOW) {
+        standardErrorMessage("La línea no es de un contador de pulsos", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+
+    uint8_t oldSREG = SREG;
+    cli();
+    pulses[line] = 0;
+    extIntEnable(line, edge, pullUp);
+    runningCounters |= _BV(line);
+    SREG = oldSREG;
+    return true;
+}
+
+void pulseCounterEnd(uint8_t line) {
+    if (line >= EXT_INT_LINES) {
+        return;
+    }
+    extIntDisable(line);
+    runningCounters &= ~_BV(line);
+}
+
+uint32_t pulseCounterRead(uint8_t line) {
+    if (line >= EXT_INT_LINES) {
+        return 0;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint32_t count = pulses[line];
+    SREG = oldSREG;
+    return count;
+}
+
+uint32_t pulseCounterTake(uint8_t line) {
+    if (line >= EXT_INT_LINES) {
+        return 0;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint32_t count = pulses[line];
+    pulses[line] = 0;
+    SREG = oldSREG;
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Benchmark hooks: the ISR bodies run on scratch state with interrupts off, so
+// a live encoder or counter is never touched and a real edge cannot preempt
+// the benchmark halfway through a 32-bit update. The vector entry and exit
+// (response, jmp, register saves, reti) are not included
+
+#if ENCODER_INT_LINES & 0x03
+#define ENCODER_BENCH_PAIR 0
+#elif ENCODER_INT_LINES & 0x0C
+#define ENCODER_BENCH_PAIR 1
+#elif ENCODER_INT_LINES & 0x30
+#define ENCODER_BENCH_PAIR 2
+#endif
+
+void encoderBenchEdges(uint8_t count) {
+#ifdef ENCODER_BENCH_PAIR
+    // The pins do not move: after the first call the table step is 0
+    static Quadrature scratch;
+    uint8_t oldSREG = SREG;
+    cli();
+    while (count-- > 0) {
+        quadratureEdge<ENCODER_BENCH_PAIR>(scratch);
+    }
+    SREG = oldSREG;
+#else
+    (void)count;
+#endif
+}
+
+void pulseCounterBenchEdges(uint8_t count) {
+#if COUNTER_INT_LINES
+    static volatile uint32_t scratch;
+    uint8_t oldSREG = SREG;
+    cli();
+    while (count-- > 0) {
+        countPulse(scratch);
+    }
+    SREG = oldSREG;
+#else
+    (void)count;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Shell
+
+bool encoderCommand(const char*) {
+    static uint8_t row = 0;       // Encoder pairs first, then counter lines
+
+    if (runningEncoders == 0 && runningCounters == 0) {
+        standardErrorMessage("No hay encoders ni contadores en marcha", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return true;
+    }
+    // One line per call, once the previous one has left
+    if (!serialOutputIdle()) {
+        return false;
+    }
+    for (; row < ENCODER_PAIRS + EXT_INT_LINES; ++row) {
+        if (row < ENCODER_PAIRS && (runningEncoders & _BV(row))) {
+            showEncoderCount(row, encoderCount(row), encoderSkips(row));
+            ++row;
+            return false;
+        }
+        const uint8_t line = row - ENCODER_PAIRS;
+        if (row >= ENCODER_PAIRS && (runningCounters & _BV(line))) {
+            showPulseCount(line, pulseCounterRead(line));
+            ++row;
+            return false;
+        }
+    }
+    row = 0;
+    return true;
+}
+
+#endif // FEATURE_ENCODER
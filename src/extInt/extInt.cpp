@@ -0,0 +1,63 @@
+#include "extInt/extInt.h"
+#include "powerManager/powerManager.h"
+#include "pinout/pinout.h"
+
+// INT4-INT7 lines enabled on an edge: each holds POWER_NEED_IO_CLOCK
+static uint8_t clockedLines = 0;
+
+/**
+ * @brief Holds or releases the I/O clock for `line`. Call with interrupts disabled.
+ *
+ * INT7:4 detect edges with the I/O clock, which POWER_DOWN stops; only a
+ * low level wakes the MCU there. INT3:0 edges are asynchronous.
+ */
+static void updateClockNeed(uint8_t line, bool edgeEnabled) {
+    if (line < 4) {
+        return;
+    }
+    const bool held = clockedLines & _BV(line);
+    if (edgeEnabled && !held) {
+        clockedLines |= _BV(line);
+        powerRequire(POWER_NEED_IO_CLOCK);
+    } else if (!edgeEnabled && held) {
+        clockedLines &= ~_BV(line);
+        powerRelease(POWER_NEED_IO_CLOCK);
+    }
+}
+
+bool extIntEnable(uint8_t line, ExtIntSense sense, bool pullUp) {
+    if (line >= EXT_INT_LINES) {
+        return false;
+    }
+
+    pinMode(extIntPin(line), pullUp ? INPUT_PULLUP : INPUT);
+    pinClaim(extIntPin(line));
+
+    uint8_t oldSREG = SREG;
+    cli();
+    EIMSK &= ~_BV(line);     // Changing ISCn may raise a spurious request
+    if (line < 4) {
+        const uint8_t shift = line * 2;
+        EICRA = (EICRA & ~(0x03 << shift)) | (sense << shift);
+    } else {
+        const uint8_t shift = (line - 4) * 2;
+        EICRB = (EICRB & ~(0x03 << shift)) | (sense << shift);
+    }
+    EIFR = _BV(line);
+    EIMSK |= _BV(line);
+    updateClockNeed(line, sense != EXT_INT_LOW);
+    SREG = oldSREG;
+    return true;
+}
+
+void extIntDisable(uint8_t line) {
+    if (line >= EXT_INT_LINES) {
+        return;
+    }
+
+    uint8_t oldSREG = SREG;
+    cli();
+    EIMSK &= ~_BV(line);
+    updateClockNeed(line, false);
+    SREG = oldSREG;
+}
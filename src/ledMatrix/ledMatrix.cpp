@@ -0,0 +1,440 @@
+#include "buildConfig.h"
+
+#if FEATURE_LED_MATRIX
+
+#include "ledMatrix/ledMatrix.h"
+#include "pinout/pinout.h"
+#include "msg/msg.h"
+
+LedMatrix* LedMatrix::active = nullptr;
+LedCharlieplex* LedCharlieplex::active = nullptr;
+
+/**
+ * @brief Resolves a pin into its port and registers it in a port table.
+ *
+ * Looks the pin's port up in `ports` and appends it if it is not present yet,
+ * accumulating the pin's bit in the port mask.
+ *
+ * @param pin       Physical pin number.
+ * @param ports     Port table of the driver.
+ * @param numPorts  Number of used entries in `ports` (updated).
+ * @param maxPorts  Capacity of `ports`.
+ * @param portIdx   Index of the pin's port in `ports` (output).
+ * @param bitMask   Bit mask of the pin in its port (output).
+ * @return false if the pin is not a GPIO pin or the table is full.
+ */
+static bool resolvePortPin(uint8_t pin, PortMask* ports, uint8_t& numPorts, uint8_t maxPorts,
+                           uint8_t& portIdx, uint8_t& bitMask) {
+    if (isPinInGPIO(pin) == false) {
+        return false;
+    }
+
+    volatile uint8_t* out = portOutputRegister(digitalPinToPort(pin));
+    bitMask = digitalPinToBitMask(pin);
+
+    for (uint8_t i = 0; i < numPorts; ++i) {
+        if (ports[i].out == out) {
+            ports[i].mask |= bitMask;
+            portIdx = i;
+            return true;
+        }
+    }
+
+    if (numPorts >= maxPorts) {
+        return false;
+    }
+
+    ports[numPorts].out  = out;
+    ports[numPorts].ddr  = portModeRegister(digitalPinToPort(pin));
+    ports[numPorts].mask = bitMask;
+    portIdx = numPorts++;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// LedMatrix
+
+/**
+ * @brief Constructor of the LedMatrix class.
+ *
+ * Resolves every row and column pin into port registers and bit masks and
+ * configures them as outputs with every row released and every column LOW.
+ */
+LedMatrix::LedMatrix(const uint8_t* rowPins, uint8_t rows, const uint8_t* colPins, uint8_t cols) :
+    numRows(rows),
+    numCols(cols),
+    numColPorts(0),
+    valid(false),
+    front(0),
+    flipPending(false),
+    currentRow(0)
+    {
+        memset(frame, 0, sizeof(frame));
+        memset(image, 0, sizeof(image));
+
+        if (rows == 0 || rows > MAX_ROWS || cols == 0 || cols > MAX_COLS) {
+            standardErrorMessage("Dimensiones de matriz no soportadas", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            return;
+        }
+
+        for (uint8_t r = 0; r < rows; ++r) {
+            if (isPinInGPIO(rowPins[r]) == false) {
+                standardErrorMessage("El pin de fila no existe en la configuración de PinGIO", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+                return;
+            }
+            rowOut[r] = portOutputRegister(digitalPinToPort(rowPins[r]));
+            rowBit[r] = digitalPinToBitMask(rowPins[r]);
+        }
+
+        for (uint8_t c = 0; c < cols; ++c) {
+            if (resolvePortPin(colPins[c], colPorts, numColPorts, MAX_PORTS, colPort[c], colBit[c]) == false) {
+                standardErrorMessage("Pin de columna no valido o demasiados puertos", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+                return;
+            }
+        }
+
+        // Rows released (HIGH), columns LOW: every LED off
+        for (uint8_t r = 0; r < rows; ++r) {
+            pinMode(rowPins[r], OUTPUT);
+            digitalWrite(rowPins[r], HIGH);
+        }
+        for (uint8_t c = 0; c < cols; ++c) {
+            pinMode(colPins[c], OUTPUT);
+            digitalWrite(colPins[c], LOW);
+        }
+
+        valid = true;
+    }
+
+/**
+ * @brief Starts the Timer3 scan (CTC mode, prescaler 64, 4 µs per tick).
+ *
+ * @note Timer3 also provides PWM on pins 2, 3 and 5; `analogWrite()` on those
+ *       pins is not available while the matrix is running.
+ */
+bool LedMatrix::begin(uint16_t refreshHz) {
+    if (!valid || refreshHz == 0) {
+        return false;
+    }
+
+    uint32_t ticks = 250000UL / ((uint32_t)refreshHz * numRows);
+    if (ticks < 2) {
+        ticks = 2;
+    } else if (ticks > 65536UL) {
+        ticks = 65536UL;
+    }
+
+    present();
+
+    uint8_t oldSREG = SREG;
+    cli();
+    active = this;
+    currentRow = 0;
+    TIMSK3 = 0;
+    TCCR3A = 0;
+    TCCR3B = _BV(WGM32) | _BV(CS31) | _BV(CS30);
+    TCNT3  = 0;
+    OCR3A  = (uint16_t)(ticks - 1);
+    TIMSK3 = _BV(OCIE3A);
+    SREG = oldSREG;
+
+    return true;
+}
+
+/**
+ * @brief Stops the Timer3 scan and releases every row.
+ */
+void LedMatrix::end() {
+    uint8_t oldSREG = SREG;
+    cli();
+    TIMSK3 = 0;
+    TCCR3B = 0;
+    if (active == this) {
+        active = nullptr;
+    }
+    for (uint8_t r = 0; r < numRows && valid; ++r) {
+        *rowOut[r] |= rowBit[r];
+    }
+    SREG = oldSREG;
+}
+
+void LedMatrix::set(uint8_t row, uint8_t col, bool state) {
+    if (row >= numRows || col >= numCols) {
+        return;
+    }
+    if (state) {
+        frame[row] |= (uint16_t)1 << col;
+    } else {
+        frame[row] &= ~((uint16_t)1 << col);
+    }
+}
+
+void LedMatrix::clear() {
+    memset(frame, 0, sizeof(frame));
+}
+
+/**
+ * @brief Converts the logical frame into column port images and requests a flip.
+ *
+ * The scan keeps running while the back buffer is rebuilt, so the flip itself
+ * is left to `scan()`, which swaps buffers only when it wraps to row 0. A frame
+ * still waiting for its flip is withdrawn first and overwritten; it was never shown.
+ */
+void LedMatrix::present() {
+    uint8_t oldSREG = SREG;
+    cli();
+    flipPending = false;
+    const uint8_t back = front ^ 1;
+    SREG = oldSREG;
+
+    for (uint8_t r = 0; r < numRows; ++r) {
+        uint8_t* img = image[back][r];
+        memset(img, 0, MAX_PORTS);
+        for (uint8_t c = 0; c < numCols; ++c) {
+            if (frame[r] & ((uint16_t)1 << c)) {
+                img[colPort[c]] |= colBit[c];
+            }
+        }
+    }
+
+    oldSREG = SREG;
+    cli();
+    if (active == this) {
+        flipPending = true;
+    } else {
+        front = back;
+    }
+    SREG = oldSREG;
+}
+
+/**
+ * @brief Releases the current row, loads the next row's columns and selects it.
+ */
+void LedMatrix::scan() {
+    *rowOut[currentRow] |= rowBit[currentRow];
+
+    uint8_t r = currentRow + 1;
+    if (r >= numRows) {
+        r = 0;
+        if (flipPending) {
+            front ^= 1;
+            flipPending = false;
+        }
+    }
+
+    const uint8_t* img = image[front][r];
+    for (uint8_t p = 0; p < numColPorts; ++p) {
+        volatile uint8_t* out = colPorts[p].out;
+        *out = (*out & ~colPorts[p].mask) | img[p];
+    }
+
+    *rowOut[r] &= ~rowBit[r];
+    currentRow = r;
+}
+
+void LedMatrix::onTimerInterrupt() {
+    if (active != nullptr) {
+        active->scan();
+    }
+}
+
+ISR(TIMER3_COMPA_vect) {
+    LedMatrix::onTimerInterrupt();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// LedCharlieplex
+
+/**
+ * @brief Constructor of the LedCharlieplex class.
+ *
+ * Resolves every pin into port registers and bit masks.
+ * The pins are not touched until `begin()`.
+ */
+LedCharlieplex::LedCharlieplex(const uint8_t* pins, uint8_t count) :
+    numPins(count),
+    numPorts(0),
+    valid(false),
+    front(0),
+    flipPending(false),
+    currentAnode(0)
+    {
+        memset(frame, 0, sizeof(frame));
+        memset(ddrImage, 0, sizeof(ddrImage));
+        memset(outImage, 0, sizeof(outImage));
+
+        if (count < 2 || count > MAX_PINS) {
+            standardErrorMessage("Numero de pines charlieplex no soportado", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            numPins = 0;
+            return;
+        }
+
+        for (uint8_t i = 0; i < count; ++i) {
+            if (resolvePortPin(pins[i], ports, numPorts, MAX_PORTS, pinPort[i], pinBit[i]) == false) {
+                standardErrorMessage("Pin charlieplex no valido o demasiados puertos", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+                return;
+            }
+        }
+
+        valid = true;
+    }
+
+/**
+ * @brief Starts the Timer2 scan (CTC mode, prescaler 256, 16 µs per tick).
+ *
+ * @note Timer2 also provides PWM on pins 9 and 10; `analogWrite()` on those
+ *       pins is not available while the array is running.
+ */
+bool LedCharlieplex::begin(uint16_t refreshHz) {
+    if (!valid || refreshHz == 0) {
+        return false;
+    }
+
+    uint32_t ticks = 62500UL / ((uint32_t)refreshHz * numPins);
+    if (ticks < 2) {
+        ticks = 2;
+    } else if (ticks > 256) {
+        ticks = 256;
+    }
+
+    present();
+
+    uint8_t oldSREG = SREG;
+    cli();
+    for (uint8_t p = 0; p < numPorts; ++p) {
+        *ports[p].ddr &= ~ports[p].mask;
+        *ports[p].out &= ~ports[p].mask;
+    }
+    active = this;
+    currentAnode = 0;
+    TIMSK2 = 0;
+    TCCR2A = _BV(WGM21);
+    TCCR2B = _BV(CS22) | _BV(CS21);
+    TCNT2  = 0;
+    OCR2A  = (uint8_t)(ticks - 1);
+    TIMSK2 = _BV(OCIE2A);
+    SREG = oldSREG;
+
+    return true;
+}
+
+/**
+ * @brief Stops the Timer2 scan and leaves every pin in high impedance.
+ */
+void LedCharlieplex::end() {
+    uint8_t oldSREG = SREG;
+    cli();
+    TIMSK2 = 0;
+    TCCR2B = 0;
+    if (active == this) {
+        active = nullptr;
+    }
+    for (uint8_t p = 0; p < numPorts; ++p) {
+        *ports[p].ddr &= ~ports[p].mask;
+        *ports[p].out &= ~ports[p].mask;
+    }
+    SREG = oldSREG;
+}
+
+void LedCharlieplex::set(uint8_t index, bool state) {
+    if (index >= size()) {
+        return;
+    }
+    const uint8_t anode = index / (numPins - 1);
+    uint8_t cathode = index % (numPins - 1);
+    if (cathode >= anode) {
+        ++cathode;
+    }
+    if (state) {
+        frame[anode] |= (uint8_t)(1 << cathode);
+    } else {
+        frame[anode] &= (uint8_t)~(1 << cathode);
+    }
+}
+
+void LedCharlieplex::clear() {
+    memset(frame, 0, sizeof(frame));
+}
+
+/**
+ * @brief Converts the logical frame into DDR/PORT images per anode and requests a flip.
+ *
+ * For each anode the image drives the anode HIGH and every lit cathode LOW;
+ * all other pins stay as inputs without pull-up (high impedance). As in
+ * `LedMatrix::present()`, `scan()` swaps buffers only when it wraps to anode 0.
+ */
+void LedCharlieplex::present() {
+    uint8_t oldSREG = SREG;
+    cli();
+    flipPending = false;
+    const uint8_t back = front ^ 1;
+    SREG = oldSREG;
+
+    for (uint8_t a = 0; a < numPins; ++a) {
+        uint8_t* ddr = ddrImage[back][a];
+        uint8_t* out = outImage[back][a];
+        memset(ddr, 0, MAX_PORTS);
+        memset(out, 0, MAX_PORTS);
+
+        if (frame[a] == 0) {
+            continue;
+        }
+
+        ddr[pinPort[a]] |= pinBit[a];
+        out[pinPort[a]] |= pinBit[a];
+        for (uint8_t c = 0; c < numPins; ++c) {
+            if (frame[a] & (1 << c)) {
+                ddr[pinPort[c]] |= pinBit[c];
+            }
+        }
+    }
+
+    oldSREG = SREG;
+    cli();
+    if (active == this) {
+        flipPending = true;
+    } else {
+        front = back;
+    }
+    SREG = oldSREG;
+}
+
+/**
+ * @brief Blanks every pin and drives the next anode with its precomputed images.
+ */
+void LedCharlieplex::scan() {
+    for (uint8_t p = 0; p < numPorts; ++p) {
+        *ports[p].ddr &= ~ports[p].mask;
+        *ports[p].out &= ~ports[p].mask;
+    }
+
+    uint8_t a = currentAnode + 1;
+    if (a >= numPins) {
+        a = 0;
+        if (flipPending) {
+            front ^= 1;
+            flipPending = false;
+        }
+    }
+
+    const uint8_t* ddr = ddrImage[front][a];
+    const uint8_t* out = outImage[front][a];
+    for (uint8_t p = 0; p < numPorts; ++p) {
+        *ports[p].out |= out[p];
+        *ports[p].ddr |= ddr[p];
+    }
+
+    currentAnode = a;
+}
+
+void LedCharlieplex::onTimerInterrupt() {
+    if (active != nullptr) {
+        active->scan();
+    }
+}
+
+ISR(TIMER2_COMPA_vect) {
+    LedCharlieplex::onTimerInterrupt();
+}
+
+#endif // FEATURE_LED_MATRIX
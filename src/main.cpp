@@ -3,42 +3,98 @@
 #include <HardwareSerial.h>
 #include <Stream.h>
 #include <Print.h>
-//Headers necesarios para Debugging
-#include <avr8-stub.h>
 //Configuración del proyecto
 #include "configuracion.h"
+//Headers necesarios para Debugging
+#if FEATURE_DEBUGGER
+#include <avr8-stub.h>
+#endif
 //Pinout 
 #include "pinout/pinout.h"
 //Mensaje del sistema
 #include "msg/msg.h"
 //SensorLed
 #include "sensors_Led/sensor_Led.h"
+//Configuración persistente en EEPROM
+#include "configStore/configStore.h"
+//Registro de dispositivos
+#include "deviceRegistry/deviceRegistry.h"
+//Tiempos de arranque
+#include "bootProfile/bootProfile.h"
+//Planificador cooperativo
+#include "scheduler/scheduler.h"
+//Perfilador de tiempos de ejecución
+#include "profiler/profiler.h"
+//Monitor de pila y heap
+#include "memoryMonitor/memoryMonitor.h"
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void setup() {
+#if FEATURE_CONFIG_STORE
+  // Carga la configuración guardada en EEPROM (valores por defecto si no es válida)
+  const bool storedConfiguration = loadConfiguration();
+#endif
+  bootMark(BOOT_CONFIG);
   if (systemConfiguration.debugMode) {
     // Inicializa el programa en modo depuración
+#if FEATURE_DEBUGGER
     debug_init();  
+#endif
+  }else if (systemConfiguration.fastBoot) {
+    // Arranque rápido: sin esperas; banner, informes y diagnóstico los genera
+    // en segundo plano el dispositivo bootReport
+    Serial.begin(57600);
+#if FEATURE_CONFIG_STORE
+    if (!storedConfiguration) {
+      standardErrorMessage("Configuracion EEPROM no valida, se usan valores por defecto", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+    }
+#endif
+    bootMark(BOOT_SERIAL);
+    // Inicializa los pines de configuración principal
+    initializeMainConfigurationPins(systemConfiguration);
+    bootMark(BOOT_PINS);
   }else{
     // Inicializa el programa en modo ejecución
     // Iniciar la comunicación serial a 57600 baudio
     Serial.begin(57600);
      // Espera a que el puerto esté listo (opcional en Mega); 
     while (!Serial);
+    bootMark(BOOT_SERIAL);
     // Mensaje de inicio del sistema     
     standardMessage("Sistema iniciado modo ejecucion", __FILE__,__FUNCTION__, __DATE__, __TIME__);
+#if FEATURE_CONFIG_STORE
+    if (!storedConfiguration) {
+      standardErrorMessage("Configuracion EEPROM no valida, se usan valores por defecto", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+    }
+#endif
+    bootMark(BOOT_BANNER);
     // Diagnóstico completo del sistema entradas/salidas
     fullDiagnostics();
+    bootMark(BOOT_DIAGNOSTICS);
     // Inicializa los pines de configuración principal
     initializeMainConfigurationPins(systemConfiguration);
+    bootMark(BOOT_PINS);
     // Mensaje de configuración proyecto
     showConfigurationMessage(systemConfiguration);
+    // Memoria reservada por los pools de drivers
+    showMemoryPoolReport();
   };
+  // Activa el tick del planificador y crea las tareas de los dispositivos habilitados
+  profilerBegin();
+  memoryMonitorBegin();
+  schedulerBegin();
+  deviceRegistryBegin();
+  bootMark(BOOT_DEVICES);
+  if (!systemConfiguration.debugMode && !systemConfiguration.fastBoot) {
+    // Tiempos de cada fase del arranque
+    showBootTimingMessage();
+  }
 };
 
 
 
 void loop() {
-      ledRojo->conmutacionEstadoPorTiempo(2000); // Enciende el LED rojo
+      // Ejecuta las tareas vencidas; sin tareas pendientes la CPU duerme hasta el siguiente tick
+      schedulerRun();
 }
\ No newline at end of file
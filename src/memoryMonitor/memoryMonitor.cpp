@@ -0,0 +1,94 @@
+#include "buildConfig.h"
+
+#if FEATURE_MEMORY_MONITOR
+
+#include "memoryMonitor/memoryMonitor.h"
+#include "scheduler/scheduler.h"
+#include "msg/msg.h"
+
+// Provided by the linker script and by malloc() (avr-libc)
+extern uint8_t __heap_start;
+extern uint8_t* __brkval;
+
+static uint8_t* heapPeak = &__heap_start;         // Highest heap top seen
+static uint8_t* stackMark = (uint8_t*)RAMEND + 1; // Lowest byte written by the stack
+static uint8_t* scanPtr = &__heap_start;          // Next byte of the current pass
+static bool marginWarned = false;
+
+/**
+ * @brief Paints free SRAM with the canary before .data/.bss are initialized.
+ *
+ * Runs in .init3: the stack pointer and r1 are set up, nothing is on the
+ * stack yet and the function is reached by fall-through (naked, no return).
+ */
+__attribute__((naked, used, section(".init3")))
+static void memoryPaint() {
+    uint8_t* p = &__heap_start;
+    while (p <= (uint8_t*)RAMEND) {
+        *p++ = MEMORY_CANARY;
+    }
+}
+
+/**
+ * @brief Current end of the heap (its start while malloc() was never called).
+ */
+static uint8_t* heapTop() {
+    return __brkval != nullptr ? __brkval : &__heap_start;
+}
+
+void memoryMonitorBegin() {
+    schedulerSetIdleHook(memoryMonitorPoll);
+}
+
+void memoryMonitorPoll() {
+    uint8_t* top = heapTop();
+    if (top > heapPeak) {
+        heapPeak = top;
+    }
+    // Below the peak the heap has overwritten the canary, even after shrinking
+    if (scanPtr < heapPeak) {
+        scanPtr = heapPeak;
+    }
+
+    for (uint8_t budget = MEMORY_SCAN_BYTES; budget > 0; --budget) {
+        if (scanPtr < stackMark && *scanPtr == MEMORY_CANARY) {
+            ++scanPtr;
+            continue;
+        }
+
+        // End of the pass: first byte touched by the stack
+        if (scanPtr < stackMark) {
+            stackMark = scanPtr;
+        }
+        scanPtr = heapPeak;
+
+        const uint16_t margin = stackMark > heapPeak ? stackMark - heapPeak : 0;
+        if (margin < MEMORY_WARN_MARGIN && !marginWarned) {
+            marginWarned = true;
+            standardErrorMessage("Pila y heap a punto de colisionar (margen < MEMORY_WARN_MARGIN)", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        }
+        return;
+    }
+}
+
+MemoryUsage memoryUsage() {
+    uint8_t oldSREG = SREG;
+    cli();
+    uint8_t* const sp = (uint8_t*)SP;
+    SREG = oldSREG;
+
+    uint8_t* const top = heapTop();
+    uint8_t* const ramEnd = (uint8_t*)RAMEND;
+
+    MemoryUsage usage;
+    usage.staticBytes = &__heap_start - (uint8_t*)RAMSTART;
+    usage.heapBytes = top - &__heap_start;
+    usage.heapPeak = heapPeak - &__heap_start;
+    usage.stackBytes = ramEnd - sp;
+    usage.stackPeak = ramEnd + 1 - (stackMark < sp ? stackMark : sp + 1);
+    usage.freeBytes = sp > top ? sp - top : 0;
+    usage.margin = stackMark > heapPeak ? stackMark - heapPeak : 0;
+    return usage;
+}
+
+#endif // FEATURE_MEMORY_MONITOR
@@ -0,0 +1,19 @@
+#include "memoryPool/memoryPool.h"
+
+const PoolBase* PoolBase::head = nullptr;
+
+/**
+ * @brief Constructor of the PoolBase class.
+ *
+ * Pools are global objects, so registration happens during static
+ * initialization, before setup() runs.
+ */
+PoolBase::PoolBase(const char* name, uint16_t objectSize, uint8_t capacity) :
+    usedCount(0),
+    poolName(name),
+    slotSize(objectSize),
+    slotCount(capacity),
+    nextPool(head)
+    {
+        head = this;
+    }
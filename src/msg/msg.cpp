@@ -1,4 +1,13 @@
 #include "msg/msg.h"
+#include "memoryPool/memoryPool.h"
+#include "deviceRegistry/deviceRegistry.h"
+#include "bootProfile/bootProfile.h"
+#include "powerManager/powerManager.h"
+#include "profiler/profiler.h"
+#include "memoryMonitor/memoryMonitor.h"
+#include "spscQueue/spscQueue.h"
+#include "dataBus/dataBus.h"
+#include "sensor/sensor.h"
 
 /**
  * @brief Prints an enriched log message to the serial monitor.
@@ -77,6 +86,24 @@ void standardErrorMessage(const char* message, const char* file, const char* fun
   Serial.println();
 }
 
+/**
+ * @brief Returns true when the serial transmit buffer is empty.
+ */
+bool serialOutputIdle() {
+  return Serial.availableForWrite() >= SERIAL_TX_BUFFER_SIZE - 1;
+}
+
+/**
+ * @brief Returns the n-th entry of a registration list, or nullptr past its end.
+ */
+template <typename T>
+static const T* listEntry(const T* entry, uint8_t n) {
+  while (entry != nullptr && n-- > 0) {
+    entry = entry->next();
+  }
+  return entry;
+}
+
 /**
  * @brief Prints the current system configuration status to the serial monitor.
  * 
@@ -88,14 +115,489 @@ void standardErrorMessage(const char* message, const char* file, const char* fun
  * @param configuration  Reference to the current system configuration structure.
  */
 void showConfigurationMessage(const configuracionMain& configuration) {
-  Serial.println(); // Initial line break
-  Serial.println("📋 Current configuration status:");
-  Serial.println("----------------------------------------");
-  Serial.print("🔧 Debug mode: ");
-  Serial.println(configuration.debugMode ? "Enabled" : "Disabled");
+  for (uint8_t piece = 0; showConfigurationPiece(configuration, piece); ++piece) {
+  }
+}
 
-  Serial.print("💡 LED project: ");
-  Serial.println(configuration.proyectoLed ? "Enabled" : "Disabled");
+bool showConfigurationPiece(const configuracionMain& configuration, uint8_t piece) {
+  switch (piece) {
+    case 0:
+      Serial.println(); // Initial line break
+      Serial.println("📋 Current configuration status:");
+      Serial.println("----------------------------------------");
+      return true;
+    case 1:
+      Serial.print("🔧 Debug mode: ");
+      Serial.println(configuration.debugMode ? "Enabled" : "Disabled");
+      Serial.print("💡 LED project: ");
+      Serial.println(configuration.proyectoLed ? "Enabled" : "Disabled");
+      return true;
+    case 2:
+      Serial.print("⚡ Fast boot: ");
+      Serial.println(configuration.fastBoot ? "Enabled" : "Disabled");
+      Serial.print("🔋 Low power console: ");
+      Serial.println(configuration.lowPower ? "Enabled" : "Disabled");
+      return true;
+    case 3:
+      Serial.println("----------------------------------------");
+      Serial.println(); // Final line break
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Prints the memory reserved by every static driver pool.
+ *
+ * Walks the list of registered pools and prints, for each module, the slots
+ * in use, the slot size and the bytes reserved at compile time, followed by
+ * the total. None of this memory comes from the heap.
+ */
+void showMemoryPoolReport() {
+  for (uint8_t piece = 0; showMemoryPoolPiece(piece); ++piece) {
+  }
+}
+
+bool showMemoryPoolPiece(uint8_t piece) {
+  if (piece == 0) {
+    Serial.println();
+    Serial.println("📦 Static driver pools:");
+    Serial.println("----------------------------------------");
+    return true;
+  }
+
+  const PoolBase* pool = listEntry(PoolBase::first(), piece - 1);
+  if (pool != nullptr) {
+    Serial.print("🧱 ");
+    Serial.print(pool->name());
+    Serial.print(": ");
+    Serial.print(pool->used());
+    Serial.print("/");
+    Serial.print(pool->capacity());
+    Serial.print(" x ");
+    Serial.print(pool->objectSize());
+    Serial.print(" B = ");
+    Serial.print(pool->reservedBytes());
+    Serial.println(" B");
+    return true;
+  }
+  // The footer follows the last pool
+  if (piece > 1 && listEntry(PoolBase::first(), piece - 2) == nullptr) {
+    return false;
+  }
+
+  uint16_t total = 0;
+  for (pool = PoolBase::first(); pool != nullptr; pool = pool->next()) {
+    total += pool->reservedBytes();
+  }
+  Serial.print("Total reserved: ");
+  Serial.print(total);
+  Serial.println(" B");
   Serial.println("----------------------------------------");
-  Serial.println(); // Final line break
+  Serial.println();
+  return true;
+}
+
+/**
+ * @brief Prints every registered device with its timing statistics.
+ *
+ * Names are read from flash. Times are measured with micros() (4 µs resolution)
+ * around each poll made by the registry dispatcher.
+ */
+void showDeviceRegistryReport() {
+  for (uint8_t piece = 0; showDeviceRegistryPiece(piece); ++piece) {
+  }
+}
+
+bool showDeviceRegistryPiece(uint8_t piece) {
+  if (piece == 0) {
+    Serial.println();
+    Serial.println("🗂️ Registered devices:");
+    Serial.println("----------------------------------------");
+    return true;
+  }
+  if (piece == deviceCount + 1) {
+    Serial.println("----------------------------------------");
+    Serial.print("Deadline misses (all tasks): ");
+    Serial.println(schedulerDeadlineMisses());
+    Serial.println();
+    return true;
+  }
+  if (piece > deviceCount + 1) {
+    return false;
+  }
+
+  const uint8_t id = piece - 1;
+  Serial.print(deviceEnabled(id) ? "🟢 " : "⚪ ");
+  Serial.print((const __FlashStringHelper*)pgm_read_ptr(&deviceTable[id].name));
+  Serial.print(" every ");
+  Serial.print(pgm_read_word(&deviceTable[id].periodMs));
+  Serial.print(" ms, priority ");
+  Serial.print(pgm_read_byte(&deviceTable[id].priority));
+
+  const TaskStats* stats = schedulerTaskStats(deviceTaskId(id));
+  if (stats == nullptr) {
+    Serial.println();
+    return true;
+  }
+  Serial.print(": runs ");
+  Serial.print(stats->runs);
+  Serial.print(", mean ");
+  Serial.print(stats->runs > 0 ? stats->totalMicros / stats->runs : 0UL);
+  Serial.print(" us, max ");
+  Serial.print(stats->maxMicros);
+  Serial.print(" us, late ");
+  Serial.print(stats->maxLateMs);
+  Serial.print(" ms, misses ");
+  Serial.println(stats->deadlineMisses);
+  return true;
+}
+
+/**
+ * @brief Prints the time accounted to each power mode.
+ *
+ * Percentages are relative to millis(), which includes the time compensated
+ * after POWER_DOWN periods.
+ */
+void showPowerReport() {
+  for (uint8_t piece = 0; showPowerPiece(piece); ++piece) {
+  }
+}
+
+bool showPowerPiece(uint8_t piece) {
+  const uint32_t uptimeMs = millis();
+
+  if (piece == 0) {
+    Serial.println();
+    Serial.print("🔋 Power modes (uptime ");
+    Serial.print(uptimeMs);
+    Serial.println(" ms):");
+    Serial.println("----------------------------------------");
+    return true;
+  }
+  if (piece == POWER_MODE_COUNT + 1) {
+    Serial.println("----------------------------------------");
+    Serial.println();
+    return true;
+  }
+  if (piece > POWER_MODE_COUNT + 1) {
+    return false;
+  }
+
+  const PowerMode mode = (PowerMode)(piece - 1);
+  const PowerModeStats stats = powerModeStats(mode);
+  Serial.print(powerModeName(mode));
+  Serial.print(": ");
+  Serial.print(stats.totalMs);
+  Serial.print(" ms (");
+  Serial.print(uptimeMs >= 100 ? stats.totalMs / (uptimeMs / 100) : 0UL);
+  Serial.print("%), ");
+  Serial.print(stats.entries);
+  Serial.println(mode == POWER_MODE_ACTIVE ? " wake-ups" : " entries");
+  return true;
+}
+
+/**
+ * @brief Prints a Timer1 interval in µs with one decimal.
+ */
+static void printProfilerTicks(uint32_t ticks) {
+  Serial.print(ticks / PROFILER_TICKS_PER_US);
+  Serial.print(".");
+  Serial.print((ticks % PROFILER_TICKS_PER_US) * 10 / PROFILER_TICKS_PER_US);
+}
+
+/**
+ * @brief Prints the name of a profiler slot: the device owning a task slot, if any.
+ */
+static void printProfilerSlotName(uint8_t slot) {
+  if (slot == PROFILE_SLOT_LOOP) {
+    Serial.print("loop");
+    return;
+  }
+  if (slot == PROFILE_SLOT_JITTER) {
+    Serial.print("jitter");
+    return;
+  }
+
+  const uint8_t taskId = slot - PROFILE_SLOT_TASK0;
+  for (uint8_t id = 0; id < deviceCount; ++id) {
+    if (deviceTaskId(id) == taskId) {
+      Serial.print((const __FlashStringHelper*)pgm_read_ptr(&deviceTable[id].name));
+      return;
+    }
+  }
+  Serial.print("task");
+  Serial.print(taskId);
+}
+
+/**
+ * @brief Prints every profiler slot with samples in one compact line.
+ */
+void showProfilerReport() {
+  for (uint8_t piece = 0; showProfilerPiece(piece); ++piece) {
+  }
+}
+
+bool showProfilerPiece(uint8_t piece) {
+  if (piece >= PROFILER_SLOTS) {
+    return false;
+  }
+  const ProfileStats* stats = profilerStats(piece);
+  if (stats == nullptr || stats->count == 0) {
+    return true;
+  }
+
+  uint8_t first = 0;
+  uint8_t last = PROFILER_BUCKETS - 1;
+  while (stats->histogram[first] == 0) {
+    ++first;
+  }
+  while (stats->histogram[last] == 0) {
+    --last;
+  }
+
+  Serial.print("📊 ");
+  printProfilerSlotName(piece);
+  Serial.print(" n=");
+  Serial.print(stats->count);
+  Serial.print(" min=");
+  printProfilerTicks(stats->minTicks);
+  Serial.print(" mean=");
+  printProfilerTicks(stats->totalTicks / stats->count);
+  Serial.print(" max=");
+  printProfilerTicks(stats->maxTicks);
+  Serial.print(" hist@");
+  printProfilerTicks(first == 0 ? 0 : (1UL << first));
+  Serial.print(":");
+  for (uint8_t bucket = first; bucket <= last; ++bucket) {
+    Serial.print(" ");
+    Serial.print(stats->histogram[bucket]);
+  }
+  Serial.println();
+  return true;
+}
+
+/**
+ * @brief Prints SRAM usage in one line: heap and stack as now/peak.
+ */
+void showMemoryReport() {
+  showMemoryPiece(0);
+}
+
+bool showMemoryPiece(uint8_t piece) {
+  if (piece > 0) {
+    return false;
+  }
+  const MemoryUsage usage = memoryUsage();
+  Serial.print("🧱 SRAM [bytes] static=");
+  Serial.print(usage.staticBytes);
+  Serial.print(" heap=");
+  Serial.print(usage.heapBytes);
+  Serial.print("/");
+  Serial.print(usage.heapPeak);
+  Serial.print(" stack=");
+  Serial.print(usage.stackBytes);
+  Serial.print("/");
+  Serial.print(usage.stackPeak);
+  Serial.print(" free=");
+  Serial.print(usage.freeBytes);
+  Serial.print(" margin=");
+  Serial.println(usage.margin);
+  return true;
+}
+
+/**
+ * @brief Prints every registered queue, one line each.
+ */
+void showQueueReport() {
+  for (uint8_t piece = 0; showQueuePiece(piece); ++piece) {
+  }
+}
+
+bool showQueuePiece(uint8_t piece) {
+  if (QueueBase::first() == nullptr) {
+    if (piece > 0) {
+      return false;
+    }
+    Serial.println("📨 No queues registered");
+    return true;
+  }
+  const QueueBase* queue = listEntry(QueueBase::first(), piece);
+  if (queue == nullptr) {
+    return false;
+  }
+  Serial.print("📨 ");
+  Serial.print(queue->name());
+  Serial.print(": ");
+  Serial.print(queue->size());
+  Serial.print("/");
+  Serial.print(queue->capacity());
+  Serial.print(" x ");
+  Serial.print(queue->elementSize());
+  Serial.print(" B, peak ");
+  Serial.print(queue->highWater());
+  Serial.print(", overruns ");
+  Serial.println(queue->overruns());
+  return true;
+}
+
+/**
+ * @brief Prints every topic of the data bus, one line each.
+ */
+void showBusReport() {
+  for (uint8_t piece = 0; showBusPiece(piece); ++piece) {
+  }
+}
+
+bool showBusPiece(uint8_t piece) {
+  if (piece >= TOPIC_COUNT) {
+    return false;
+  }
+  const TopicId topic = (TopicId)piece;
+  Serial.print("📡 ");
+  Serial.print((const __FlashStringHelper*)busTopicName(topic));
+  Serial.print(": seq ");
+  Serial.print(busSequence(topic));
+  Serial.print(", ");
+  Serial.print(busSubscriberCount(topic));
+  Serial.println(" subscribers");
+  return true;
+}
+
+/**
+ * @brief Prints every registered sensor, one line each.
+ */
+void showSensorReport() {
+  for (uint8_t piece = 0; showSensorPiece(piece); ++piece) {
+  }
+}
+
+bool showSensorPiece(uint8_t piece) {
+  if (SensorBase::first() == nullptr) {
+    if (piece > 0) {
+      return false;
+    }
+    Serial.println("🌡️ No sensors registered");
+    return true;
+  }
+  const SensorBase* sensor = listEntry(SensorBase::first(), piece);
+  if (sensor == nullptr) {
+    return false;
+  }
+  const SensorStats& stats = sensor->stats();
+  Serial.print("🌡️ ");
+  Serial.print(sensor->name());
+  Serial.print(": n=");
+  Serial.print(stats.samples);
+  Serial.print(" err=");
+  Serial.print(stats.errors);
+  Serial.print(" lat=");
+  Serial.print(stats.lastLatencyUs);
+  Serial.print("/");
+  Serial.print(stats.maxLatencyUs);
+  Serial.print(" us period=");
+  Serial.print(sensor->periodMs());
+  Serial.println(" ms");
+  return true;
+}
+
+/**
+ * @brief Prints one benchmark line; the time has one decimal.
+ */
+void showBenchmarkResult(const char* name, uint32_t cycles, bool rate) {
+  const uint8_t cyclesPerUs = F_CPU / 1000000UL;
+  Serial.print("⏱️ ");
+  Serial.print((const __FlashStringHelper*)name);
+  Serial.print(": ");
+  Serial.print(cycles);
+  Serial.print(" cycles (");
+  Serial.print(cycles / cyclesPerUs);
+  Serial.print(".");
+  Serial.print((cycles % cyclesPerUs) * 10 / cyclesPerUs);
+  Serial.print(" us)");
+  if (rate && cycles > 0) {
+    Serial.print(" max ");
+    Serial.print(F_CPU / 1000UL / cycles);
+    Serial.print(" kHz");
+  }
+  Serial.println();
+}
+
+/**
+ * @brief Prints the I2C engine counters in one line.
+ */
+void showTwiReport(const TwiStats& stats) {
+  Serial.print("🔧 I2C ok=");
+  Serial.print(stats.completed);
+  Serial.print(" nack=");
+  Serial.print(stats.nacks);
+  Serial.print(" bus=");
+  Serial.print(stats.busErrors);
+  Serial.print(" timeout=");
+  Serial.println(stats.timeouts);
+}
+
+/**
+ * @brief Prints the addresses set in a scan bitmap.
+ */
+void showTwiScan(const uint8_t found[16]) {
+  Serial.print("🔧 I2C devices:");
+  bool any = false;
+  for (uint8_t address = 0; address < 128; ++address) {
+    if (found[address >> 3] & _BV(address & 0x07)) {
+      Serial.print(" 0x");
+      if (address < 0x10) {
+        Serial.print("0");
+      }
+      Serial.print(address, HEX);
+      any = true;
+    }
+  }
+  Serial.println(any ? "" : " none");
+}
+
+/**
+ * @brief Prints the position and missed edges of one encoder.
+ */
+void showEncoderCount(uint8_t pair, int32_t count, uint16_t skips) {
+  Serial.print("🎛️ enc");
+  Serial.print(pair);
+  Serial.print(": ");
+  Serial.print(count);
+  Serial.print(" counts skips=");
+  Serial.println(skips);
+}
+
+/**
+ * @brief Prints the count of one pulse counter.
+ */
+void showPulseCount(uint8_t line, uint32_t count) {
+  Serial.print("🎛️ INT");
+  Serial.print(line);
+  Serial.print(": ");
+  Serial.print(count);
+  Serial.println(" pulses");
+}
+
+/**
+ * @brief Prints the boot phase timestamps in one compact line.
+ *
+ * Each value is micros() at the end of the phase; phases not reached
+ * (for example diagnostics still running in the background) print "-".
+ */
+void showBootTimingMessage() {
+  Serial.print("⏱️ Boot [us]");
+  for (uint8_t phase = 0; phase < BOOT_PHASE_COUNT; ++phase) {
+    const uint32_t timestamp = bootPhaseMicros((BootPhase)phase);
+    Serial.print(" ");
+    Serial.print(bootPhaseName((BootPhase)phase));
+    Serial.print("=");
+    if (timestamp == 0) {
+      Serial.print("-");
+    } else {
+      Serial.print(timestamp);
+    }
+  }
+  Serial.println();
 }
@@ -0,0 +1,194 @@
+#include "buildConfig.h"
+
+#if FEATURE_ONE_WIRE
+
+#include "oneWire/oneWire.h"
+
+// Slot timing (µs), inside the limits of the DS18B20 datasheet
+constexpr uint16_t ONE_WIRE_RESET_US = 480;       // Reset pulse
+constexpr uint16_t ONE_WIRE_PRESENCE_US = 70;     // Release to presence check
+constexpr uint16_t ONE_WIRE_RESET_TAIL_US = 410;  // Rest of the 480 µs presence window
+constexpr uint16_t ONE_WIRE_SLOT_US = 70;         // Slot start to the next one
+constexpr uint8_t ONE_WIRE_LOW_US = 2;            // Low pulse of a 1 or read slot
+constexpr uint8_t ONE_WIRE_RECOVERY_US = 5;       // High time after a 0 slot
+constexpr uint16_t ONE_WIRE_SAMPLE_US = 15;       // A read slot shorter than this is a 1
+
+static constexpr uint16_t usToTicks(uint16_t us) {
+    return us * TIMEBASE_TICKS_PER_US;
+}
+
+/**
+ * @brief Step of the transaction the next compare interrupt performs.
+ */
+enum OneWirePhase : uint8_t {
+    PHASE_IDLE,
+    PHASE_RESET,        // End of the reset pulse
+    PHASE_PRESENCE,     // Presence check
+    PHASE_SLOTS         // End of a slot and start of the next
+};
+
+/**
+ * @brief Kind of the slot in progress.
+ */
+enum OneWireSlot : uint8_t {
+    SLOT_NONE,
+    SLOT_WRITE_0,
+    SLOT_WRITE_1,
+    SLOT_READ
+};
+
+static volatile OneWireStatus status = ONE_WIRE_IDLE;
+static OneWirePhase phase = PHASE_IDLE;
+static OneWireSlot slotKind;
+static uint16_t slotStart;               // TCNT5 when the slot pulled the line low
+
+static const uint8_t* writeBytes;
+static uint8_t* readBytes;
+static uint16_t writeBits;
+static uint16_t totalBits;
+static uint16_t bitIndex;                // Next slot
+
+static volatile uint8_t* busDdr = nullptr;
+static uint8_t busMask;
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Line control: the output latch stays at 0, so the pin is either low or released
+
+static inline void busLow() {
+    *busDdr |= busMask;
+}
+
+static inline void busRelease() {
+    *busDdr &= ~busMask;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Engine (called with interrupts disabled)
+
+static void finish(OneWireStatus result) {
+    busRelease();
+    TIMSK5 &= ~_BV(OCIE5A);
+    phase = PHASE_IDLE;
+    status = result;
+    timebaseCaptureEnd();
+}
+
+/**
+ * @brief Closes the slot in progress (reads its bit) and opens the next one.
+ */
+static void nextSlot() {
+    if (slotKind == SLOT_WRITE_0) {
+        busRelease();
+        delayMicroseconds(ONE_WIRE_RECOVERY_US);
+    } else if (slotKind == SLOT_READ) {
+        // The rising edge that ended the slot is latched in ICR5
+        if (!(TIFR5 & _BV(ICF5))) {
+            finish(ONE_WIRE_BUS_ERROR);
+            return;
+        }
+        if ((uint16_t)(ICR5 - slotStart) < usToTicks(ONE_WIRE_SAMPLE_US)) {
+            const uint16_t bit = bitIndex - 1 - writeBits;
+            readBytes[bit >> 3] |= _BV(bit & 0x07);
+        }
+    }
+
+    if (bitIndex == totalBits) {
+        finish(ONE_WIRE_DONE);
+        return;
+    }
+
+    bool one = true;
+    if (bitIndex < writeBits) {
+        one = writeBytes[bitIndex >> 3] & _BV(bitIndex & 0x07);
+        slotKind = one ? SLOT_WRITE_1 : SLOT_WRITE_0;
+    } else {
+        slotKind = SLOT_READ;
+    }
+    ++bitIndex;
+
+    busLow();
+    slotStart = TCNT5;
+    if (one) {
+        TIFR5 = _BV(ICF5);
+        delayMicroseconds(ONE_WIRE_LOW_US);
+        busRelease();
+    }
+    OCR5A = slotStart + usToTicks(ONE_WIRE_SLOT_US);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// API
+
+bool oneWireStart(const uint8_t* writeData, uint8_t writeLength, uint8_t* readData, uint8_t readLength) {
+    if (status == ONE_WIRE_BUSY || (writeLength > 0 && writeData == nullptr) || (readLength > 0 && readData == nullptr)) {
+        return false;
+    }
+    // Presence is a falling edge; the first slot switches to rising edges
+    if (!timebaseCaptureClaim(CAPTURE_FALLING, false)) {
+        return false;
+    }
+
+    if (busDdr == nullptr) {
+        digitalWrite(ONE_WIRE_PIN, LOW);
+        pinMode(ONE_WIRE_PIN, INPUT);
+        busDdr = portModeRegister(digitalPinToPort(ONE_WIRE_PIN));
+        busMask = digitalPinToBitMask(ONE_WIRE_PIN);
+    }
+
+    for (uint8_t i = 0; i < readLength; ++i) {
+        readData[i] = 0;
+    }
+    writeBytes = writeData;
+    readBytes = readData;
+    writeBits = (uint16_t)writeLength * 8;
+    totalBits = writeBits + (uint16_t)readLength * 8;
+    bitIndex = 0;
+    slotKind = SLOT_NONE;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    status = ONE_WIRE_BUSY;
+    phase = PHASE_RESET;
+    busLow();
+    OCR5A = TCNT5 + usToTicks(ONE_WIRE_RESET_US);
+    TIFR5 = _BV(OCF5A);
+    TIMSK5 |= _BV(OCIE5A);
+    SREG = oldSREG;
+    return true;
+}
+
+OneWireStatus oneWireStatus() {
+    return status;
+}
+
+ISR(TIMER5_COMPA_vect) {
+    switch (phase) {
+    case PHASE_RESET:
+        busRelease();
+        TIFR5 = _BV(ICF5);
+        OCR5A = OCR5A + usToTicks(ONE_WIRE_PRESENCE_US);
+        phase = PHASE_PRESENCE;
+        break;
+
+    case PHASE_PRESENCE:
+        // The presence pulse lasts 60-240 µs: its falling edge stays latched
+        if (!(TIFR5 & _BV(ICF5))) {
+            finish(ONE_WIRE_NO_PRESENCE);
+            break;
+        }
+        TCCR5B |= _BV(ICES5);
+        OCR5A = OCR5A + usToTicks(ONE_WIRE_RESET_TAIL_US);
+        phase = PHASE_SLOTS;
+        break;
+
+    case PHASE_SLOTS:
+        nextSlot();
+        break;
+
+    default:
+        TIMSK5 &= ~_BV(OCIE5A);
+        break;
+    }
+}
+
+#endif // FEATURE_ONE_WIRE
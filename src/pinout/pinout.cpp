@@ -2,6 +2,9 @@
 #include <Arduino.h>
 #include "pinout/pinout.h"
 
+// Bit n = pin n claimed by a driver
+static uint8_t claimedPins[(NUM_DIGITAL_PINS + 7) / 8];
+
 /**
  * @brief Diagnostic for digital GPIO pins configured as input with pull-up resistor.
  * 
@@ -80,6 +83,92 @@ void fullDiagnostics() {
     Serial.println("\n✅ Full diagnostic complete.\n");
 }
 
+/**
+ * @brief Returns true if no driver claimed a pin and it is still in its reset state.
+ *
+ * A plain input looks like the reset state, so drivers using one (an external
+ * interrupt, MISO, the capture pin) claim it; any other pin configured as
+ * output or with pull-up is also considered in use.
+ */
+static bool isPinUntouched(uint8_t pinNumber) {
+    if (pinClaimed(pinNumber)) {
+        return false;
+    }
+    const uint8_t port = digitalPinToPort(pinNumber);
+    const uint8_t mask = digitalPinToBitMask(pinNumber);
+    return (*portModeRegister(port) & mask) == 0 && (*portOutputRegister(port) & mask) == 0;
+}
+
+/**
+ * @brief Incremental diagnostic of GPIO and PWM pins for the fast-boot path.
+ *
+ * Performs the same checks as fullDiagnostics() but one pin action per call:
+ * the first call configures a pin, the next one reads and prints it, so the
+ * settle time is the interval between calls instead of delay(5). Pins already
+ * configured by a driver are reported and left untouched.
+ *
+ * @return true when every pin has been checked.
+ */
+bool backgroundDiagnosticsStep() {
+    static uint8_t index = 0;     // GPIO pins first, then PWM pins
+    static bool armed = false;    // Pin configured, read on the next call
+
+    const uint8_t total = Pins::NUM_GPIO + Pins::NUM_PWM;
+    if (index >= total) {
+        return true;
+    }
+
+    const bool isGpio = index < Pins::NUM_GPIO;
+    const PinInfo& pin = isGpio ? Pins::GPIO[index] : Pins::PWM[index - Pins::NUM_GPIO];
+
+    if (!armed) {
+        if (index == 0) {
+            Serial.println("➡️ Checking digital pins (GPIO, background):");
+        } else if (index == Pins::NUM_GPIO) {
+            Serial.println("\n➡️ Checking PWM pins (background):");
+        }
+
+        if (!isPinUntouched(pin.number)) {
+            Serial.print("🔒 ");
+            Serial.print(pin.name);
+            Serial.print(" [Pin ");
+            Serial.print(pin.number);
+            Serial.println("] → In use by a driver, skipped");
+            ++index;
+            return false;
+        }
+
+        if (isGpio) {
+            pinMode(pin.number, INPUT_PULLUP);   // Configure as input with pull-up resistor
+        } else {
+            pinMode(pin.number, OUTPUT);         // Configure as output
+            digitalWrite(pin.number, HIGH);      // Set pin to HIGH
+        }
+        armed = true;
+        return false;
+    }
+
+    int state = digitalRead(pin.number);
+    Serial.print(isGpio ? "🔍 " : "🌀 ");
+    Serial.print(pin.name);
+    Serial.print(" [Pin ");
+    Serial.print(pin.number);
+    Serial.print("] → State: ");
+    if (isGpio) {
+        Serial.println(state == LOW ? "Connected to ground (LOW)" : "Floating (HIGH)");
+        digitalWrite(pin.number, LOW);           // Force pin to LOW state to avoid false readings
+    } else {
+        Serial.println(state == HIGH ? "Working correctly" : "Fault or conflict");
+    }
+
+    armed = false;
+    if (++index >= total) {
+        Serial.println("\n✅ Full diagnostic complete.\n");
+        return true;
+    }
+    return false;
+}
+
 /**
  * @brief Checks if a given pin number exists in the GPIO pin list.
  * 
@@ -97,3 +186,21 @@ bool isPinInGPIO(int pinNumber) {
     }
     return false;
 }
+
+/**
+ * @brief Marks a pin as owned by a driver; backgroundDiagnosticsStep() skips it.
+ *
+ * @param pinNumber Arduino pin number (out-of-range numbers are ignored).
+ */
+void pinClaim(uint8_t pinNumber) {
+    if (pinNumber < NUM_DIGITAL_PINS) {
+        claimedPins[pinNumber / 8] |= _BV(pinNumber % 8);
+    }
+}
+
+/**
+ * @brief Returns true if a driver has claimed the pin with pinClaim().
+ */
+bool pinClaimed(uint8_t pinNumber) {
+    return pinNumber < NUM_DIGITAL_PINS && (claimedPins[pinNumber / 8] & _BV(pinNumber % 8));
+}
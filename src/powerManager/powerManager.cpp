@@ -0,0 +1,250 @@
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#include "powerManager/powerManager.h"
+
+// Kept by the Arduino core (wiring.c), advanced here while Timer0 is stopped
+extern volatile unsigned long timer0_millis;
+
+// POWER_DOWN is slept in watchdog slices of 32 ms (4K cycles of the 128 kHz
+// oscillator): an early wake loses at most part of one slice
+constexpr uint8_t WDT_SLICE_MS = 32;
+constexpr uint8_t WDT_SLICE_PRESCALER = _BV(WDP0);
+
+static uint8_t needCount[POWER_NEED_COUNT];
+static PowerModeStats modeStats[POWER_MODE_COUNT];
+
+static bool consoleLowPower = false;
+static uint32_t consoleAwakeSinceMs = 0;
+static bool consoleAwake = true;
+static volatile bool watchdogFired = false;
+static volatile bool consoleWake = false;
+
+static const char* const modeNames[POWER_MODE_COUNT] = {
+    "active", "idle", "power-down"
+};
+
+/**
+ * @brief Watchdog in interrupt mode: end of a POWER_DOWN period.
+ */
+ISR(WDT_vect) {
+    watchdogFired = true;
+}
+
+/**
+ * @brief Edge on RX0 (PE0 = PCINT8) while the console sleeps.
+ */
+ISR(PCINT1_vect) {
+    PCMSK1 &= ~_BV(PCINT8);
+    consoleWake = true;
+}
+
+void powerRequire(PowerNeed need) {
+    if (need >= POWER_NEED_COUNT) {
+        return;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    if (needCount[need] < 0xFF) {
+        needCount[need]++;
+    }
+    SREG = oldSREG;
+}
+
+void powerRelease(PowerNeed need) {
+    if (need >= POWER_NEED_COUNT) {
+        return;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    if (needCount[need] > 0) {
+        needCount[need]--;
+    }
+    SREG = oldSREG;
+}
+
+void powerConsoleLowPower(bool enabled) {
+    consoleLowPower = enabled;
+    powerConsoleActivity();
+}
+
+void powerConsoleActivity() {
+    consoleAwakeSinceMs = millis();
+    consoleAwake = true;
+}
+
+/**
+ * @brief Returns true if a peripheral on the I/O clock is busy.
+ *
+ * Compare outputs (PWM) and timer interrupts need their timer running; Timer0
+ * only counts its PWM outputs, its interrupts belong to millis() and the tick.
+ * INT7:4 enabled on an edge, and a serial transmission pending like in
+ * HardwareSerial::flush(), also keep it.
+ */
+static bool ioClockInUse() {
+    if (needCount[POWER_NEED_IO_CLOCK] > 0) {
+        return true;
+    }
+
+    if ((TCCR0A & 0xF0) || (TCCR2A & 0xF0) ||
+        (TCCR1A & 0xFC) || (TCCR3A & 0xFC) || (TCCR4A & 0xFC) || (TCCR5A & 0xFC)) {
+        return true;
+    }
+
+    if (TIMSK1 || TIMSK2 || TIMSK3 || TIMSK4 || TIMSK5) {
+        return true;
+    }
+
+    if (ADCSRA & _BV(ADSC)) {
+        return true;
+    }
+
+    // INT7:4 only see edges with the clock (attachInterrupt() does not declare them)
+    for (uint8_t line = 4; line < 8; ++line) {
+        if ((EIMSK & _BV(line)) && ((EICRB >> ((line - 4) * 2)) & 0x03)) {
+            return true;
+        }
+    }
+
+    return (UCSR0B & _BV(UDRIE0)) || ((UCSR0B & _BV(TXEN0)) && !(UCSR0A & _BV(TXC0)));
+}
+
+/**
+ * @brief Adds `micros` to the time of `mode`.
+ */
+static void account(PowerMode mode, uint32_t micros) {
+    PowerModeStats& stats = modeStats[mode];
+    const uint32_t total = stats.remainderMicros + micros;
+    stats.totalMs += total / 1000;
+    stats.remainderMicros = total % 1000;
+}
+
+/**
+ * @brief Sleeps in IDLE until the next interrupt.
+ */
+static void sleepIdle() {
+    const uint32_t start = micros();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+
+    modeStats[POWER_MODE_IDLE].entries++;
+    account(POWER_MODE_IDLE, micros() - start);
+}
+
+/**
+ * @brief Writes the watchdog control register within the 4-cycle WDCE window.
+ *
+ * Both values are in registers before the first store, like wdt_enable().
+ */
+static inline void watchdogWrite(uint8_t control) {
+    __asm__ __volatile__ (
+        "sts %0, %1" "\n\t"
+        "sts %0, %2" "\n\t"
+        :
+        : "n" (_SFR_MEM_ADDR(WDTCSR)), "r" ((uint8_t)(_BV(WDCE) | _BV(WDE))), "r" (control)
+        : "memory"
+    );
+}
+
+/**
+ * @brief Sleeps in POWER_DOWN for up to `slices` watchdog slices.
+ *
+ * The watchdog is not reset between slices, so consecutive slices are whole
+ * periods regardless of the oscillator start-up time. A wake by any other
+ * interrupt ends the sleep: the slices completed are credited in full and the
+ * interrupted one by half, which bounds the error to half a slice.
+ *
+ * @return ms slept.
+ */
+static uint16_t sleepPowerDown(uint16_t slices) {
+    // Watchdog in interrupt mode (no reset)
+    wdt_reset();
+    watchdogWrite(_BV(WDIE) | WDT_SLICE_PRESCALER);
+
+    if (consoleLowPower && !consoleAwake) {
+        consoleWake = false;
+        PCIFR = _BV(PCIF1);
+        PCMSK1 |= _BV(PCINT8);
+        PCICR |= _BV(PCIE1);
+    }
+
+    uint16_t slept = 0;
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    for (uint16_t slice = 0; slice < slices; ++slice) {
+        watchdogFired = false;
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+        cli();
+
+        if (!watchdogFired) {
+            slept += WDT_SLICE_MS / 2;
+            break;
+        }
+        slept += WDT_SLICE_MS;
+    }
+
+    MCUSR &= ~_BV(WDRF);
+    wdt_disable();
+
+    timer0_millis += slept;
+
+    modeStats[POWER_MODE_POWER_DOWN].entries++;
+    account(POWER_MODE_POWER_DOWN, (uint32_t)slept * 1000UL);
+
+    if (consoleWake) {
+        consoleWake = false;
+        consoleAwakeSinceMs = timer0_millis;
+        consoleAwake = true;
+    }
+
+    sei();
+    return slept;
+}
+
+uint16_t powerSleep(uint32_t budgetMs) {
+    if (consoleAwake && consoleLowPower && millis() - consoleAwakeSinceMs >= CONSOLE_AWAKE_MS) {
+        consoleAwake = false;
+    }
+    const bool uartRxInUse = needCount[POWER_NEED_UART_RX] > 0 || !consoleLowPower || consoleAwake;
+
+    // Slices that end before the deadline, with a 1/8 margin for the
+    // tolerance of the watchdog oscillator
+    const uint32_t usableMs = budgetMs - budgetMs / 8;
+    if (uartRxInUse || usableMs < WDT_SLICE_MS || ioClockInUse()) {
+        sleepIdle();
+        return 0;
+    }
+
+    // The ms slept are returned in 16 bits
+    const uint32_t slices = usableMs / WDT_SLICE_MS;
+    const uint16_t maxSlices = 0xFFFF / WDT_SLICE_MS;
+    return sleepPowerDown(slices > maxSlices ? maxSlices : (uint16_t)slices);
+}
+
+PowerModeStats powerModeStats(PowerMode mode) {
+    if (mode >= POWER_MODE_COUNT) {
+        return PowerModeStats();
+    }
+    if (mode != POWER_MODE_ACTIVE) {
+        return modeStats[mode];
+    }
+
+    // Active: everything that was not accounted as sleep
+    PowerModeStats active = PowerModeStats();
+    const uint32_t uptimeMs = millis();
+    uint32_t sleptMs = 0;
+    for (uint8_t m = POWER_MODE_IDLE; m < POWER_MODE_COUNT; ++m) {
+        active.entries += modeStats[m].entries;
+        sleptMs += modeStats[m].totalMs;
+    }
+    active.totalMs = uptimeMs > sleptMs ? uptimeMs - sleptMs : 0;
+    return active;
+}
+
+const char* powerModeName(PowerMode mode) {
+    return mode < POWER_MODE_COUNT ? modeNames[mode] : "?";
+}
@@ -0,0 +1,71 @@
+#include "buildConfig.h"
+
+#if FEATURE_PROFILER
+
+#include "profiler/profiler.h"
+
+static ProfileStats slots[PROFILER_SLOTS];
+
+// floor(log2(n)) of a nibble, 0 for 0
+static const uint8_t nibbleLog2[16] PROGMEM = {
+    0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+};
+
+/**
+ * @brief floor(log2(value)) by table lookup on the highest non-zero nibble.
+ */
+static inline uint8_t log2Bucket(uint16_t value) {
+    const uint8_t high = value >> 8;
+    const uint8_t byte = high ? high : (uint8_t)value;
+    const uint8_t base = high ? 8 : 0;
+    if (byte >> 4) {
+        return base + 4 + pgm_read_byte(&nibbleLog2[byte >> 4]);
+    }
+    return base + pgm_read_byte(&nibbleLog2[byte]);
+}
+
+void profilerBegin() {
+    uint8_t oldSREG = SREG;
+    cli();
+    TIMSK1 = 0;
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11);   // Normal mode, clk/8
+    TCNT1 = 0;
+    SREG = oldSREG;
+
+    profilerReset();
+}
+
+void profilerRecord(uint8_t slot, uint16_t elapsedTicks) {
+    if (slot >= PROFILER_SLOTS) {
+        return;
+    }
+
+    ProfileStats& stats = slots[slot];
+    stats.count++;
+    stats.totalTicks += elapsedTicks;
+    if (elapsedTicks < stats.minTicks) {
+        stats.minTicks = elapsedTicks;
+    }
+    if (elapsedTicks > stats.maxTicks) {
+        stats.maxTicks = elapsedTicks;
+    }
+
+    uint16_t& bucket = stats.histogram[log2Bucket(elapsedTicks)];
+    if (bucket != 0xFFFF) {
+        ++bucket;
+    }
+}
+
+const ProfileStats* profilerStats(uint8_t slot) {
+    return slot < PROFILER_SLOTS ? &slots[slot] : nullptr;
+}
+
+void profilerReset() {
+    memset(slots, 0, sizeof(slots));
+    for (uint8_t slot = 0; slot < PROFILER_SLOTS; ++slot) {
+        slots[slot].minTicks = 0xFFFF;
+    }
+}
+
+#endif // FEATURE_PROFILER
@@ -0,0 +1,273 @@
+#include "scheduler/scheduler.h"
+#include "powerManager/powerManager.h"
+#include "profiler/profiler.h"
+
+// Timer0 cycle: prescaler 64, 256 counts (set up by the Arduino core)
+constexpr uint16_t TICK_MICROS = 64UL * 256UL / (F_CPU / 1000000UL);
+constexpr uint8_t TICK_MILLIS = TICK_MICROS / 1000;
+constexpr uint16_t TICK_FRACTION = TICK_MICROS % 1000;
+
+/**
+ * @brief Entry of the task table.
+ */
+struct Task {
+    TaskFunction function;   // nullptr = free slot
+    uint32_t releaseMs;      // Next release time
+    uint16_t periodMs;       // 0 = one-shot
+    uint16_t deadlineMs;     // Relative to the release, 0 = none
+    TaskPriority priority;
+    TaskStats stats;
+};
+
+static Task tasks[MAX_TASKS];
+static uint32_t nextReleaseMs = 0;           // Earliest release among the active tasks
+static uint8_t runningTask = INVALID_TASK;   // Slot being executed, not reusable until it returns
+static uint32_t totalMisses = 0;
+static TaskFunction idleHook = nullptr;
+static bool deferRequested = false;          // schedulerDefer() called by the running task
+static uint16_t deferMs = 0;
+
+static volatile uint32_t tickMillis = 0;
+static volatile uint16_t tickFraction = 0;   // µs below one ms
+static volatile bool tickPending = false;    // Tick since the last dispatch pass
+static volatile uint16_t tickStamp = 0;      // Profiler time of the last tick
+
+/**
+ * @brief Scheduler tick: Timer0 compare match A, once per Timer0 cycle.
+ */
+ISR(TIMER0_COMPA_vect) {
+    uint32_t ms = tickMillis + TICK_MILLIS;
+    uint16_t fraction = tickFraction + TICK_FRACTION;
+    if (fraction >= 1000) {
+        fraction -= 1000;
+        ++ms;
+    }
+    tickMillis = ms;
+    tickFraction = fraction;
+    tickPending = true;
+    tickStamp = profilerNow();
+}
+
+void schedulerBegin() {
+    uint8_t oldSREG = SREG;
+    cli();
+    TIFR0 = _BV(OCF0A);      // Discard a stale compare flag
+    TIMSK0 |= _BV(OCIE0A);   // OCR0A only sets the phase of the tick
+    SREG = oldSREG;
+}
+
+uint32_t schedulerMillis() {
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint32_t ms = tickMillis;
+    SREG = oldSREG;
+    return ms;
+}
+
+/**
+ * @brief Stores a task in the first free slot.
+ */
+static uint8_t addTask(TaskFunction function, uint16_t delayMs, uint16_t periodMs, TaskPriority priority, uint16_t deadlineMs) {
+    if (function == nullptr) {
+        return INVALID_TASK;
+    }
+
+    for (uint8_t id = 0; id < MAX_TASKS; ++id) {
+        Task& task = tasks[id];
+        if (task.function != nullptr || id == runningTask) {
+            continue;
+        }
+
+        task.releaseMs = schedulerMillis() + delayMs;
+        task.periodMs = periodMs;
+        task.deadlineMs = deadlineMs;
+        task.priority = priority;
+        task.stats = TaskStats();
+        task.function = function;
+
+        if ((int32_t)(task.releaseMs - nextReleaseMs) < 0) {
+            nextReleaseMs = task.releaseMs;
+        }
+        return id;
+    }
+
+    return INVALID_TASK;
+}
+
+uint8_t schedulerAddPeriodic(TaskFunction function, uint16_t periodMs, TaskPriority priority, uint16_t deadlineMs) {
+    if (periodMs == 0) {
+        periodMs = 1;
+    }
+    return addTask(function, periodMs, periodMs, priority, deadlineMs == 0 ? periodMs : deadlineMs);
+}
+
+uint8_t schedulerAddOneShot(TaskFunction function, uint16_t delayMs, TaskPriority priority, uint16_t deadlineMs) {
+    return addTask(function, delayMs, 0, priority, deadlineMs);
+}
+
+void schedulerRemove(uint8_t id) {
+    if (id < MAX_TASKS) {
+        tasks[id].function = nullptr;
+    }
+}
+
+/**
+ * @brief Executes one task, updates its statistics and computes its next release.
+ *
+ * @param ticked  A tick arrived just before this pass: a task released at that
+ *                tick records its start delay in the profiler jitter slot.
+ */
+static void runTask(uint8_t id, uint32_t now, bool ticked) {
+    Task& task = tasks[id];
+    TaskStats& stats = task.stats;
+
+    const uint32_t late = now - task.releaseMs;
+    if (late > stats.maxLateMs) {
+        stats.maxLateMs = late > 0xFFFF ? 0xFFFF : (uint16_t)late;
+    }
+
+    const uint16_t profileStart = profilerNow();
+    if (ticked && late == 0) {
+        uint8_t oldSREG = SREG;
+        cli();
+        const uint16_t released = tickStamp;
+        SREG = oldSREG;
+        profilerRecord(PROFILE_SLOT_JITTER, profileStart - released);
+    }
+
+    runningTask = id;
+    deferRequested = false;
+    const uint32_t start = micros();
+    task.function();
+    const uint32_t elapsed = micros() - start;
+    runningTask = INVALID_TASK;
+    profilerStop(PROFILE_SLOT_TASK0 + id, profileStart);
+
+    // The task removed itself
+    if (task.function == nullptr) {
+        return;
+    }
+
+    stats.runs++;
+    stats.totalMicros += elapsed;
+    if (elapsed > stats.maxMicros) {
+        stats.maxMicros = elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed;
+    }
+
+    const uint32_t finished = schedulerMillis();
+    if (task.deadlineMs != 0 && finished - task.releaseMs > task.deadlineMs) {
+        stats.deadlineMisses++;
+        totalMisses++;
+    }
+
+    if (deferRequested) {
+        task.releaseMs = finished + deferMs;
+        return;
+    }
+
+    if (task.periodMs == 0) {
+        task.function = nullptr;
+        return;
+    }
+
+    // Time-triggered: the next release is one period after the previous one,
+    // not after the execution. Releases lost to an overrun are skipped.
+    task.releaseMs += task.periodMs;
+    if ((int32_t)(finished - task.releaseMs) >= 0) {
+        const uint32_t skipped = (finished - task.releaseMs) / task.periodMs + 1;
+        task.releaseMs += skipped * task.periodMs;
+        stats.deadlineMisses += skipped;
+        totalMisses += skipped;
+    }
+}
+
+/**
+ * @brief Sleeps until the next interrupt unless a tick arrived since the last pass.
+ *
+ * Interrupts are disabled between the check and `sleep_cpu()` (inside
+ * powerSleep()); the instruction after `sei` always executes, so a tick cannot
+ * be lost in between. Time slept with Timer0 stopped is added to the clock.
+ */
+static void idle(uint32_t budgetMs) {
+    cli();
+    if (tickPending) {
+        sei();
+        return;
+    }
+
+    const uint16_t sleptMs = powerSleep(budgetMs);
+    if (sleptMs > 0) {
+        cli();
+        tickMillis += sleptMs;
+        sei();
+    }
+}
+
+void schedulerRun() {
+    const bool ticked = tickPending;
+    tickPending = false;
+    uint32_t now = schedulerMillis();
+
+    if ((int32_t)(now - nextReleaseMs) < 0) {
+        if (idleHook != nullptr) {
+            idleHook();
+        }
+        idle(nextReleaseMs - now);
+        return;
+    }
+
+    const uint16_t passStart = profilerNow();
+
+    for (;;) {
+        uint8_t best = INVALID_TASK;
+        for (uint8_t id = 0; id < MAX_TASKS; ++id) {
+            const Task& task = tasks[id];
+            if (task.function == nullptr || (int32_t)(now - task.releaseMs) < 0) {
+                continue;
+            }
+            if (best == INVALID_TASK ||
+                task.priority < tasks[best].priority ||
+                (task.priority == tasks[best].priority && (int32_t)(task.releaseMs - tasks[best].releaseMs) < 0)) {
+                best = id;
+            }
+        }
+
+        if (best == INVALID_TASK) {
+            break;
+        }
+
+        runTask(best, now, ticked);
+        now = schedulerMillis();
+    }
+
+    uint32_t earliest = now + 0xFFFFUL;
+    for (uint8_t id = 0; id < MAX_TASKS; ++id) {
+        if (tasks[id].function != nullptr && (int32_t)(tasks[id].releaseMs - earliest) < 0) {
+            earliest = tasks[id].releaseMs;
+        }
+    }
+    nextReleaseMs = earliest;
+    profilerStop(PROFILE_SLOT_LOOP, passStart);
+}
+
+void schedulerDefer(uint16_t delayMs) {
+    if (runningTask != INVALID_TASK) {
+        deferRequested = true;
+        deferMs = delayMs;
+    }
+}
+
+void schedulerSetIdleHook(TaskFunction hook) {
+    idleHook = hook;
+}
+
+const TaskStats* schedulerTaskStats(uint8_t id) {
+    if (id >= MAX_TASKS || tasks[id].function == nullptr) {
+        return nullptr;
+    }
+    return &tasks[id].stats;
+}
+
+uint32_t schedulerDeadlineMisses() {
+    return totalMisses;
+}
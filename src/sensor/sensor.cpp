@@ -0,0 +1,53 @@
+#include "sensor/sensor.h"
+
+const SensorBase* SensorBase::headSensor = nullptr;
+
+/**
+ * @brief Constructor of the SensorBase class.
+ *
+ * Sensors are global objects, so registration happens during static
+ * initialization, before setup() runs.
+ */
+SensorBase::SensorBase(const char* name, uint16_t periodMs) :
+    fresh(false),
+    sensorName(name),
+    period(periodMs),
+    converting(false),
+    startMicros(0),
+    counters(),
+    nextSensor(headSensor)
+    {
+        headSensor = this;
+    }
+
+void SensorBase::resetStats() {
+    counters = SensorStats();
+}
+
+void SensorBase::conversionStarted() {
+    converting = true;
+    startMicros = micros();
+}
+
+void SensorBase::conversionFinished(SensorStep result) {
+    converting = false;
+
+    if (result != SENSOR_DONE) {
+        if (counters.errors < 0xFFFF) {
+            ++counters.errors;
+        }
+        return;
+    }
+
+    const uint32_t latency = micros() - startMicros;
+    ++counters.samples;
+    counters.lastLatencyUs = latency;
+    if (latency > counters.maxLatencyUs) {
+        counters.maxLatencyUs = latency;
+    }
+    fresh = true;
+}
+
+bool SensorBase::conversionTimedOut() const {
+    return micros() - startMicros > (uint32_t)period * SENSOR_TIMEOUT_PERIODS * 1000UL;
+}
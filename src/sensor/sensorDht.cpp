@@ -0,0 +1,139 @@
+#include "buildConfig.h"
+
+#if FEATURE_DHT
+
+#include "sensor/sensorDht.h"
+#include "timebase/timebase.h"
+#include "scheduler/scheduler.h"
+
+// Pulso de inicio (ms) de cada modelo
+constexpr uint8_t DHT11_INICIO_MS = 20;
+constexpr uint8_t DHT22_INICIO_MS = 2;
+
+// Duración máxima de la trama: 40 bits de 120 µs más la respuesta
+constexpr uint8_t DHT_TRAMA_MS = 6;
+constexpr uint8_t DHT_TRAMA_LIMITE_MS = 10;
+
+// Intervalos entre flancos de bajada (ticks de 62,5 ns)
+constexpr uint16_t DHT_RESPUESTA_MIN = 120 * TIMEBASE_TICKS_PER_US;   // 80 µs a 0 + 80 µs a 1
+constexpr uint16_t DHT_RESPUESTA_MAX = 200 * TIMEBASE_TICKS_PER_US;
+constexpr uint16_t DHT_BIT_MIN = 60 * TIMEBASE_TICKS_PER_US;          // 50 µs a 0 + 26 µs a 1
+constexpr uint16_t DHT_BIT_UNO = 100 * TIMEBASE_TICKS_PER_US;         // 50 µs a 0 + 70 µs a 1
+constexpr uint16_t DHT_BIT_MAX = 160 * TIMEBASE_TICKS_PER_US;
+
+/**
+ * @brief Constructor de la clase SensorDht.
+ */
+SensorDht::SensorDht(const char* name, DhtModelo modelo) :
+    Sensor<SensorDht, DhtSample, DHT_PERIOD_MS>(name),
+    modelo(modelo),
+    fase(FASE_ARMADO),
+    marca(0),
+    flancos()
+    {}
+
+bool SensorDht::trigger() {
+    if (fase != FASE_ARMADO) {
+        terminar();
+    }
+    return true;
+}
+
+SensorStep SensorDht::read(DhtSample& valor) {
+    const uint16_t ahora = (uint16_t)schedulerMillis();
+
+    switch (fase) {
+    case FASE_ARMADO: {
+        // El flanco de bajada del propio pulso se descarta al grabar
+        digitalWrite(TIMEBASE_CAPTURE_PIN, LOW);
+        pinMode(TIMEBASE_CAPTURE_PIN, OUTPUT);
+        if (!timebaseCaptureRecord(flancos, DHT_EDGES, CAPTURE_FALLING, true)) {
+            pinMode(TIMEBASE_CAPTURE_PIN, INPUT_PULLUP);
+            return SENSOR_ERROR;
+        }
+        fase = FASE_INICIO;
+        marca = ahora;
+        schedulerDefer(modelo == DHT_MODELO_11 ? DHT11_INICIO_MS : DHT22_INICIO_MS);
+        return SENSOR_BUSY;
+    }
+
+    case FASE_INICIO: {
+        const uint8_t inicioMs = (modelo == DHT_MODELO_11) ? DHT11_INICIO_MS : DHT22_INICIO_MS;
+        const uint16_t transcurrido = ahora - marca;
+        if (transcurrido < inicioMs) {
+            schedulerDefer(inicioMs - transcurrido);
+            return SENSOR_BUSY;
+        }
+        pinMode(TIMEBASE_CAPTURE_PIN, INPUT_PULLUP);
+        fase = FASE_RECIBIENDO;
+        marca = ahora;
+        schedulerDefer(DHT_TRAMA_MS);
+        return SENSOR_BUSY;
+    }
+
+    case FASE_RECIBIENDO:
+        if (timebaseCaptureCount() < DHT_EDGES) {
+            if ((uint16_t)(ahora - marca) >= DHT_TRAMA_LIMITE_MS) {
+                terminar();
+                return SENSOR_ERROR;
+            }
+            schedulerDefer(1);
+            return SENSOR_BUSY;
+        }
+        terminar();
+        return decodificar(valor) ? SENSOR_DONE : SENSOR_ERROR;
+    }
+
+    return SENSOR_ERROR;
+}
+
+void SensorDht::terminar() {
+    if (fase != FASE_ARMADO) {
+        timebaseCaptureEnd();
+        pinMode(TIMEBASE_CAPTURE_PIN, INPUT_PULLUP);
+        fase = FASE_ARMADO;
+    }
+}
+
+bool SensorDht::decodificar(DhtSample& valor) const {
+    const uint16_t respuesta = flancos[1] - flancos[0];
+    if (respuesta < DHT_RESPUESTA_MIN || respuesta > DHT_RESPUESTA_MAX) {
+        return false;
+    }
+
+    // El bit i acaba en el flanco que abre el bit i + 1 (o el fin de trama)
+    uint8_t datos[5] = {};
+    for (uint8_t i = 0; i < 40; ++i) {
+        const uint16_t intervalo = flancos[i + 2] - flancos[i + 1];
+        if (intervalo < DHT_BIT_MIN || intervalo > DHT_BIT_MAX) {
+            return false;
+        }
+        datos[i >> 3] <<= 1;
+        if (intervalo > DHT_BIT_UNO) {
+            datos[i >> 3] |= 1;
+        }
+    }
+
+    if ((uint8_t)(datos[0] + datos[1] + datos[2] + datos[3]) != datos[4]) {
+        return false;
+    }
+
+    if (modelo == DHT_MODELO_11) {
+        // Parte entera y décimas en bytes separados
+        valor.humedad = datos[0] * 10 + datos[1];
+        valor.temperatura = (int16_t)(datos[2] & 0x7F) * 10 + datos[3];
+        if (datos[2] & 0x80) {
+            valor.temperatura = -valor.temperatura;
+        }
+    } else {
+        // Décimas en 16 bits; la temperatura en signo y magnitud
+        valor.humedad = ((uint16_t)datos[0] << 8) | datos[1];
+        valor.temperatura = (int16_t)(((uint16_t)(datos[2] & 0x7F) << 8) | datos[3]);
+        if (datos[2] & 0x80) {
+            valor.temperatura = -valor.temperatura;
+        }
+    }
+    return true;
+}
+
+#endif // FEATURE_DHT
@@ -0,0 +1,156 @@
+#include "buildConfig.h"
+
+#if FEATURE_ULTRASONIC
+
+#include "sensor/sensorUltrasonido.h"
+#include "extInt/extInt.h"
+#include "timebase/timebase.h"
+#include "scheduler/scheduler.h"
+#include "msg/msg.h"
+
+// Cada cuánto se mira si el eco ha terminado
+constexpr uint8_t ULTRASONIDO_SONDEO_MS = 5;
+
+// Eco más largo que se espera antes de darlo por perdido
+constexpr uint8_t ULTRASONIDO_ECO_MAX_MS = 40;
+
+// Velocidad del sonido a 20 °C: mm = ticks * 343 / (2 * 16 ticks/µs * 1000)
+constexpr uint32_t ULTRASONIDO_SONIDO_M_S = 343;
+constexpr uint32_t ULTRASONIDO_DIVISOR = 2UL * TIMEBASE_TICKS_PER_US * 1000;
+
+/**
+ * @brief Flancos del eco de una línea, escritos por su ISR.
+ */
+struct EcoLinea {
+    volatile uint32_t subida;
+    volatile uint32_t bajada;
+    volatile bool alto;       // Se vio la subida de este disparo
+    volatile bool recibido;   // Se vio la bajada después
+};
+
+static EcoLinea ecos[EXT_INT_LINES];
+
+// Sensor con el eco en vuelo (nullptr = turno libre) y su disparo
+static const SensorUltrasonido* enVuelo = nullptr;
+static uint16_t ultimoDisparo = 0;
+
+/**
+ * @brief Constructor de la clase SensorUltrasonido.
+ */
+SensorUltrasonido::SensorUltrasonido(const char* name, uint8_t pinDisparo, uint8_t lineaEco) :
+    Sensor<SensorUltrasonido, uint16_t, ULTRASONIDO_PERIOD_MS>(name),
+    pinDisparo(pinDisparo),
+    lineaEco(lineaEco),
+    fase(FASE_TURNO),
+    marca(0)
+    {}
+
+bool SensorUltrasonido::trigger() {
+    if (fase != FASE_TURNO) {
+        terminar();
+    }
+    if (lineaEco >= EXT_INT_LINES || !(ULTRASONIC_INT_LINES & _BV(lineaEco))) {
+        standardErrorMessage("La línea del eco no es del ultrasonido", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+    pinMode(pinDisparo, OUTPUT);
+    return true;
+}
+
+SensorStep SensorUltrasonido::read(uint16_t& mm) {
+    const uint16_t ahora = (uint16_t)schedulerMillis();
+
+    if (fase == FASE_TURNO) {
+        if (enVuelo != nullptr) {
+            schedulerDefer(ULTRASONIDO_SONDEO_MS);
+            return SENSOR_BUSY;
+        }
+        const uint16_t desdeDisparo = ahora - ultimoDisparo;
+        if (desdeDisparo < ULTRASONIDO_CICLO_MS) {
+            schedulerDefer(ULTRASONIDO_CICLO_MS - desdeDisparo);
+            return SENSOR_BUSY;
+        }
+
+        timebaseBegin();
+        EcoLinea& eco = ecos[lineaEco];
+        eco.alto = false;
+        eco.recibido = false;
+        extIntEnable(lineaEco, EXT_INT_CHANGE, false);
+        enVuelo = this;
+        ultimoDisparo = ahora;
+
+        digitalWrite(pinDisparo, HIGH);
+        delayMicroseconds(10);
+        digitalWrite(pinDisparo, LOW);
+
+        fase = FASE_ECO;
+        marca = ahora;
+        schedulerDefer(ULTRASONIDO_SONDEO_MS);
+        return SENSOR_BUSY;
+    }
+
+    const EcoLinea& eco = ecos[lineaEco];
+    if (!eco.recibido) {
+        if ((uint16_t)(ahora - marca) >= ULTRASONIDO_ECO_MAX_MS) {
+            terminar();
+            return SENSOR_ERROR;
+        }
+        schedulerDefer(ULTRASONIDO_SONDEO_MS);
+        return SENSOR_BUSY;
+    }
+
+    // Con la línea desactivada la ISR ya no escribe los flancos
+    terminar();
+    const uint32_t ticks = eco.bajada - eco.subida;
+    const uint32_t distancia = ticks * ULTRASONIDO_SONIDO_M_S / ULTRASONIDO_DIVISOR;
+    if (distancia > ULTRASONIDO_MAX_MM) {
+        return SENSOR_ERROR;
+    }
+    mm = (uint16_t)distancia;
+    return SENSOR_DONE;
+}
+
+void SensorUltrasonido::terminar() {
+    extIntDisable(lineaEco);
+    if (enVuelo == this) {
+        enVuelo = nullptr;
+    }
+    fase = FASE_TURNO;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// ISRs: timestamp first, the same number of cycles after both edges
+
+template <uint8_t LINE>
+static inline void flancoEco() {
+    const uint32_t ahora = timebaseNow();
+    EcoLinea& eco = ecos[LINE];
+    if (extIntLevel(LINE)) {
+        eco.subida = ahora;
+        eco.alto = true;
+    } else if (eco.alto) {
+        eco.bajada = ahora;
+        eco.recibido = true;
+    }
+}
+
+#if ULTRASONIC_INT_LINES & 0x01
+ISR(INT0_vect) { flancoEco<0>(); }
+#endif
+#if ULTRASONIC_INT_LINES & 0x02
+ISR(INT1_vect) { flancoEco<1>(); }
+#endif
+#if ULTRASONIC_INT_LINES & 0x04
+ISR(INT2_vect) { flancoEco<2>(); }
+#endif
+#if ULTRASONIC_INT_LINES & 0x08
+ISR(INT3_vect) { flancoEco<3>(); }
+#endif
+#if ULTRASONIC_INT_LINES & 0x10
+ISR(INT4_vect) { flancoEco<4>(); }
+#endif
+#if ULTRASONIC_INT_LINES & 0x20
+ISR(INT5_vect) { flancoEco<5>(); }
+#endif
+
+#endif // FEATURE_ULTRASONIC
@@ -0,0 +1,314 @@
+#include "shell/shell.h"
+#include "configuracion.h"
+#include "msg/msg.h"
+#include "configStore/configStore.h"
+#include "powerManager/powerManager.h"
+#include "profiler/profiler.h"
+#include "benchmark/benchmark.h"
+#include "twi/twi.h"
+#include "encoder/encoder.h"
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Commands
+
+typedef bool (*ReportPiece)(uint8_t piece);
+
+static uint8_t stepPiece = 0;
+
+/**
+ * @brief Prints the next piece of `report` once the transmit buffer is empty.
+ *
+ * Every multi-line command goes through here, so a command never holds the
+ * loop inside Serial.write() (only one command runs at a time).
+ *
+ * @return true, and rewinds, once the report has no more pieces.
+ */
+static bool reportStep(ReportPiece report) {
+    if (!serialOutputIdle()) {
+        return false;
+    }
+    if (report(stepPiece++)) {
+        return false;
+    }
+    stepPiece = 0;
+    return true;
+}
+
+static bool configurationPiece(uint8_t piece) {
+    return showConfigurationPiece(systemConfiguration, piece);
+}
+
+#if FEATURE_BENCHMARK
+static bool benchCommand(const char*) {
+    return benchmarkStep();
+}
+#endif
+
+static bool busCommand(const char*) {
+    return reportStep(showBusPiece);
+}
+
+#if FEATURE_CONFIG_STORE
+static bool cfgCommand(const char* args) {
+    static bool showing = false;   // Command done, configuration being printed
+    if (!showing) {
+        if (!configCommand(args)) {
+            return true;
+        }
+        showing = true;
+    }
+    if (!reportStep(configurationPiece)) {
+        return false;
+    }
+    showing = false;
+    return true;
+}
+#endif
+
+static bool devCommand(const char*) {
+    return reportStep(showDeviceRegistryPiece);
+}
+
+// Reports printed by 'diag', in order
+static const ReportPiece dumpReports[] PROGMEM = {
+    configurationPiece,
+    showMemoryPoolPiece,
+    showDeviceRegistryPiece,
+    showPowerPiece,
+    showProfilerPiece,
+    showMemoryPiece,
+    showQueuePiece,
+    showBusPiece,
+    showSensorPiece
+};
+
+static uint8_t dumpReport = 0;
+
+static bool diagCommand(const char*) {
+    while (dumpReport < sizeof(dumpReports) / sizeof(dumpReports[0])) {
+        if (!reportStep((ReportPiece)pgm_read_ptr(&dumpReports[dumpReport]))) {
+            return false;
+        }
+        ++dumpReport;
+    }
+    dumpReport = 0;
+    return true;
+}
+
+static bool helpPiece(uint8_t piece);
+
+static bool helpCommand(const char*) {
+    return reportStep(helpPiece);
+}
+
+static bool memCommand(const char*) {
+    return reportStep(showMemoryPiece);
+}
+
+static bool profCommand(const char* args) {
+    if (*args == '\0') {
+        return reportStep(showProfilerPiece);
+    }
+    if (strcmp(args, "reset") == 0) {
+        profilerReset();
+    } else {
+        standardErrorMessage("Uso: prof [reset]", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+    }
+    return true;
+}
+
+static bool pwrCommand(const char*) {
+    return reportStep(showPowerPiece);
+}
+
+static bool queuesCommand(const char*) {
+    return reportStep(showQueuePiece);
+}
+
+static bool sensorsCommand(const char*) {
+    return reportStep(showSensorPiece);
+}
+
+#define SHELL_STRING(id, text) static const char id[] PROGMEM = text;
+SHELL_STRING(benchName, "bench")
+SHELL_STRING(benchHelp, "cycles per call: filters, fixed vs float, SPI, ISR edges")
+SHELL_STRING(busName, "bus")
+SHELL_STRING(busHelp, "data bus topics")
+SHELL_STRING(cfgName, "cfg")
+SHELL_STRING(cfgHelp, "[<field> <0|1> | reset] configuration")
+SHELL_STRING(devName, "dev")
+SHELL_STRING(devHelp, "device registry and task statistics")
+SHELL_STRING(diagName, "diag")
+SHELL_STRING(diagHelp, "every report")
+SHELL_STRING(encName, "enc")
+SHELL_STRING(encHelp, "encoder positions and pulse counts")
+SHELL_STRING(helpName, "help")
+SHELL_STRING(helpHelp, "this list")
+SHELL_STRING(memName, "mem")
+SHELL_STRING(memHelp, "stack/heap usage")
+SHELL_STRING(profName, "prof")
+SHELL_STRING(profHelp, "[reset] execution-time profiler")
+SHELL_STRING(pwrName, "pwr")
+SHELL_STRING(pwrHelp, "time per power mode")
+SHELL_STRING(queuesName, "queues")
+SHELL_STRING(queuesHelp, "ISR queues")
+SHELL_STRING(sensorsName, "sensors")
+SHELL_STRING(sensorsHelp, "samples, errors and latency per sensor")
+SHELL_STRING(twiName, "twi")
+SHELL_STRING(twiHelp, "[scan] I2C counters or bus scan")
+#undef SHELL_STRING
+
+// Sorted by name (checked by shellBegin)
+static const ShellCommand commands[] PROGMEM = {
+#if FEATURE_BENCHMARK
+    {benchName, benchCommand, benchHelp},
+#endif
+    {busName, busCommand, busHelp},
+#if FEATURE_CONFIG_STORE
+    {cfgName, cfgCommand, cfgHelp},
+#endif
+    {devName, devCommand, devHelp},
+    {diagName, diagCommand, diagHelp},
+#if FEATURE_ENCODER
+    {encName, encoderCommand, encHelp},
+#endif
+    {helpName, helpCommand, helpHelp},
+    {memName, memCommand, memHelp},
+    {profName, profCommand, profHelp},
+    {pwrName, pwrCommand, pwrHelp},
+    {queuesName, queuesCommand, queuesHelp},
+    {sensorsName, sensorsCommand, sensorsHelp},
+#if FEATURE_TWI
+    {twiName, twiCommand, twiHelp}
+#endif
+};
+
+constexpr uint8_t commandCount = sizeof(commands) / sizeof(commands[0]);
+
+/**
+ * @brief One 'help' line per piece: name and help of command `piece`.
+ */
+static bool helpPiece(uint8_t piece) {
+    if (piece >= commandCount) {
+        return false;
+    }
+    Serial.print((const __FlashStringHelper*)pgm_read_ptr(&commands[piece].name));
+    Serial.print(" ");
+    Serial.println((const __FlashStringHelper*)pgm_read_ptr(&commands[piece].help));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Line input and dispatch
+
+static char line[SHELL_LINE_LENGTH + 1];
+static uint8_t lineLength = 0;
+static bool lineOverflow = false;
+static ShellHandler running = nullptr;   // Command that has not finished yet
+static const char* runningArgs = nullptr;
+
+/**
+ * @brief Binary search of the command table.
+ */
+static ShellHandler findCommand(const char* name) {
+    uint8_t low = 0;
+    uint8_t high = commandCount;
+    while (low < high) {
+        const uint8_t middle = (low + high) / 2;
+        const int order = strcmp_P(name, (const char*)pgm_read_ptr(&commands[middle].name));
+        if (order == 0) {
+            return (ShellHandler)pgm_read_ptr(&commands[middle].handler);
+        }
+        if (order < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Splits a complete line into command and arguments and runs it.
+ */
+static void dispatchLine() {
+    char* args = line;
+    while (*args != '\0' && *args != ' ') {
+        ++args;
+    }
+    if (*args == ' ') {
+        *args++ = '\0';
+        while (*args == ' ') {
+            ++args;
+        }
+    }
+
+    if (line[0] == '\0') {
+        return;
+    }
+
+    ShellHandler handler = findCommand(line);
+    if (handler == nullptr) {
+        standardErrorMessage("Comando desconocido (help: lista de comandos)", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return;
+    }
+
+    if (!handler(args)) {
+        running = handler;
+        runningArgs = args;
+    }
+}
+
+void shellBegin() {
+    char previous[8];
+    for (uint8_t i = 1; i < commandCount; ++i) {
+        strncpy_P(previous, (const char*)pgm_read_ptr(&commands[i - 1].name), sizeof(previous) - 1);
+        previous[sizeof(previous) - 1] = '\0';
+        if (strcmp_P(previous, (const char*)pgm_read_ptr(&commands[i].name)) >= 0) {
+            standardErrorMessage("Tabla de comandos no ordenada", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            return;
+        }
+    }
+}
+
+void shellPoll() {
+    if (running != nullptr) {
+        if (running(runningArgs)) {
+            running = nullptr;
+        }
+        return;
+    }
+
+    // Bounded work per call: at most one receive buffer worth of characters
+    uint8_t budget = SERIAL_RX_BUFFER_SIZE;
+    while (budget-- > 0 && Serial.available() > 0) {
+        const char c = (char)Serial.read();
+
+        if (c == '\r') {
+            continue;
+        }
+
+        if (c == '\n') {
+            line[lineLength] = '\0';
+            powerConsoleActivity();
+            if (lineOverflow) {
+                standardErrorMessage("Linea de comando demasiado larga", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            } else {
+                dispatchLine();
+            }
+            lineLength = 0;
+            lineOverflow = false;
+
+            if (running != nullptr) {
+                return;  // Input waits until the command finishes
+            }
+            continue;
+        }
+
+        if (lineLength < SHELL_LINE_LENGTH) {
+            line[lineLength++] = c;
+        } else {
+            lineOverflow = true;
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#include "buildConfig.h"
+
+#if FEATURE_SHIFT_REGISTER_LED
+
+#include "shiftRegisterLed/shiftRegisterLed.h"
+#include "pinout/pinout.h"
+#include "msg/msg.h"
+#include "scheduler/scheduler.h"
+
+// SCK of the chain: 1 MHz leaves the ISR 128 cycles per byte
+constexpr uint32_t SHIFT_REGISTER_CLOCK_HZ = 1000000UL;
+
+ShiftRegisterBank* ShiftRegisterBank::firstStalled = nullptr;
+bool ShiftRegisterBank::retryArmed = false;
+
+/**
+ * @brief Constructor of the ShiftRegisterBank class.
+ */
+ShiftRegisterBank::ShiftRegisterBank(uint8_t registers, uint8_t latchPin) :
+    numRegisters(registers),
+    device(latchPin, SHIFT_REGISTER_CLOCK_HZ, 0),
+    transfer(),
+    dirty(false),
+    transferCount(0),
+    valid(false),
+    stalled(false),
+    nextStalled(nullptr)
+    {
+        memset(shadow, 0, sizeof(shadow));
+        memset(txBuffer, 0, sizeof(txBuffer));
+
+        if (registers == 0 || registers > MAX_REGISTERS) {
+            standardErrorMessage("Numero de registros 74HC595 no soportado", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            numRegisters = 0;
+            return;
+        }
+
+        transfer.device = &device;
+        transfer.txData = txBuffer;
+        transfer.length = registers;
+        transfer.done = onTransferComplete;
+        transfer.context = this;
+        valid = true;
+    }
+
+bool ShiftRegisterBank::begin() {
+    if (!valid || !device.begin()) {
+        return false;
+    }
+
+    memset(shadow, 0, sizeof(shadow));
+    requestTransfer();
+    return true;
+}
+
+void ShiftRegisterBank::on(uint8_t index) {
+    write(index, true);
+}
+
+void ShiftRegisterBank::off(uint8_t index) {
+    write(index, false);
+}
+
+void ShiftRegisterBank::conmutacionEstado(uint8_t index) {
+    write(index, !read(index));
+}
+
+void ShiftRegisterBank::write(uint8_t index, bool state) {
+    if (index >= size()) {
+        return;
+    }
+
+    const uint8_t mask = (uint8_t)(1 << (index & 7));
+    const uint8_t before = shadow[index >> 3];
+    const uint8_t after = state ? (before | mask) : (before & ~mask);
+    if (after == before) {
+        return;  // Nothing changed: no transfer
+    }
+
+    shadow[index >> 3] = after;
+    requestTransfer();
+}
+
+bool ShiftRegisterBank::read(uint8_t index) const {
+    if (index >= size()) {
+        return false;
+    }
+    return shadow[index >> 3] & (1 << (index & 7));
+}
+
+uint16_t ShiftRegisterBank::transfers() const {
+    uint8_t oldSREG = SREG;
+    cli();
+    uint16_t count = transferCount;
+    SREG = oldSREG;
+    return count;
+}
+
+void ShiftRegisterBank::requestTransfer() {
+    uint8_t oldSREG = SREG;
+    cli();
+    if (!spiFinished(transfer)) {
+        dirty = true;  // Sent by the completion callback
+    } else {
+        dirty = false;
+        if (!submitSnapshot() && !stalled) {
+            // Queue full: nothing of this bank will complete to resend it
+            stalled = true;
+            nextStalled = firstStalled;
+            firstStalled = this;
+        }
+    }
+    SREG = oldSREG;
+
+    if (firstStalled != nullptr && !retryArmed
+        && schedulerAddOneShot(retryStalled, 1, TASK_PRIORITY_NORMAL) != INVALID_TASK) {
+        retryArmed = true;
+    }
+}
+
+void ShiftRegisterBank::retryStalled() {
+    retryArmed = false;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    ShiftRegisterBank* bank = firstStalled;
+    firstStalled = nullptr;
+    SREG = oldSREG;
+
+    while (bank != nullptr) {
+        ShiftRegisterBank* next = bank->nextStalled;
+        bank->stalled = false;
+        bank->requestTransfer();   // Stalls and re-arms again if the queue is still full
+        bank = next;
+    }
+}
+
+/**
+ * @brief Must be called with interrupts disabled (main context) or from the SPI interrupt.
+ */
+bool ShiftRegisterBank::submitSnapshot() {
+    for (uint8_t i = 0; i < numRegisters; ++i) {
+        txBuffer[i] = shadow[numRegisters - 1 - i];
+    }
+    if (!spiSubmit(transfer)) {
+        dirty = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The latch (chip select) has just risen: the snapshot is on the outputs.
+ *
+ * If the shadow changed during the transfer, a new snapshot is queued at once;
+ * the engine has already freed a queue slot, so the submit cannot fail.
+ */
+void ShiftRegisterBank::onTransferComplete(SpiTransfer& transfer) {
+    ShiftRegisterBank* bank = (ShiftRegisterBank*)transfer.context;
+    bank->transferCount++;
+
+    if (bank->dirty) {
+        bank->dirty = false;
+        bank->submitSnapshot();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// ShiftRegisterLed
+
+ShiftRegisterLed::ShiftRegisterLed(ShiftRegisterBank& b, uint8_t i) :
+    bank(b),
+    index(i),
+    lastToggleTime(0)
+    {
+    }
+
+void ShiftRegisterLed::on() {
+    bank.on(index);
+}
+
+void ShiftRegisterLed::off() {
+    bank.off(index);
+}
+
+void ShiftRegisterLed::conmutacionEstado() {
+    bank.conmutacionEstado(index);
+}
+
+void ShiftRegisterLed::conmutacionEstadoPorTiempo(unsigned long tiempoAlternacia) {
+    if (millis() - lastToggleTime >= tiempoAlternacia) {
+        conmutacionEstado();
+        lastToggleTime = millis();
+    }
+}
+
+#endif // FEATURE_SHIFT_REGISTER_LED
@@ -0,0 +1,192 @@
+#include "buildConfig.h"
+
+#if FEATURE_SPI_BUS
+
+#include "spiBus/spiBus.h"
+#include "pinout/pinout.h"
+#include "msg/msg.h"
+#include "powerManager/powerManager.h"
+#include "spscQueue/spscQueue.h"
+
+// Submitted by tasks and callbacks (always with interrupts disabled), taken by the ISR
+static SpscQueue<SpiTransfer*, SPI_QUEUE_LENGTH> pendingQueue("spi");
+
+static SpiTransfer* volatile current = nullptr;
+static uint8_t byteIndex;
+static bool started = false;
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// SpiDevice
+
+/**
+ * @brief Constructor of the SpiDevice class.
+ *
+ * Picks the smallest divider whose clock does not exceed `clockHz`:
+ * F_CPU / 2^(n+1), n = 0..6, is SPR1:0 = n / 2 with SPI2X for even n below 6.
+ */
+SpiDevice::SpiDevice(uint8_t pin, uint32_t clockHz, uint8_t mode, bool lsbFirst) :
+    csPin(pin),
+    control(_BV(SPE) | _BV(MSTR)),
+    status(0),
+    csOut(nullptr),
+    csMask(0)
+    {
+        uint8_t n = 0;
+        while (n < 6 && (F_CPU >> (n + 1)) > clockHz) {
+            ++n;
+        }
+        control |= n / 2;
+        if (n % 2 == 0 && n < 6) {
+            status = _BV(SPI2X);
+        }
+        if (mode & 0x02) {
+            control |= _BV(CPOL);
+        }
+        if (mode & 0x01) {
+            control |= _BV(CPHA);
+        }
+        if (lsbFirst) {
+            control |= _BV(DORD);
+        }
+    }
+
+bool SpiDevice::begin() {
+    if (digitalPinToPort(csPin) == NOT_A_PIN) {
+        standardErrorMessage("El pin CS de SPI no existe", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+
+    spiBegin();
+    csOut = portOutputRegister(digitalPinToPort(csPin));
+    csMask = digitalPinToBitMask(csPin);
+    digitalWrite(csPin, HIGH);
+    pinMode(csPin, OUTPUT);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Engine (called with interrupts disabled)
+
+/**
+ * @brief Starts the next queued transfer, or releases the bus.
+ */
+static void startNext() {
+    SpiTransfer* next;
+    if (!pendingQueue.pop(next)) {
+        current = nullptr;
+        powerRelease(POWER_NEED_IO_CLOCK);
+        return;
+    }
+
+    current = next;
+    next->status = SPI_BUSY;
+    byteIndex = 0;
+    next->device->apply(true);
+    next->device->select();
+    SPDR = next->txData != nullptr ? next->txData[0] : SPI_FILL_BYTE;
+}
+
+ISR(SPI_STC_vect) {
+    SpiTransfer* transfer = current;
+    if (transfer == nullptr) {
+        return;
+    }
+
+    const uint8_t received = SPDR;
+    if (transfer->rxData != nullptr) {
+        transfer->rxData[byteIndex] = received;
+    }
+    if (++byteIndex < transfer->length) {
+        SPDR = transfer->txData != nullptr ? transfer->txData[byteIndex] : SPI_FILL_BYTE;
+        return;
+    }
+
+    // The next transfer leaves its queue slot before the callback can resubmit
+    transfer->device->deselect();
+    transfer->status = SPI_DONE;
+    startNext();
+    if (transfer->done != nullptr) {
+        transfer->done(*transfer);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// API
+
+void spiBegin() {
+    if (started) {
+        return;
+    }
+
+    pinMode(Pins::SPI[0].number, INPUT);    // MISO
+    pinMode(Pins::SPI[1].number, OUTPUT);   // MOSI
+    pinMode(Pins::SPI[2].number, OUTPUT);   // SCK
+    digitalWrite(Pins::SPI[3].number, HIGH);
+    pinMode(Pins::SPI[3].number, OUTPUT);   // SS as output keeps the SPI in master mode
+    for (size_t i = 0; i < Pins::NUM_SPI; ++i) {
+        pinClaim(Pins::SPI[i].number);
+    }
+    started = true;
+}
+
+bool spiSubmit(SpiTransfer& transfer) {
+    if (!spiFinished(transfer)) {
+        return false;
+    }
+    if (transfer.device == nullptr || transfer.length == 0) {
+        standardErrorMessage("Transferencia SPI no válida", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+
+    uint8_t oldSREG = SREG;
+    cli();
+    transfer.status = SPI_QUEUED;
+    if (!pendingQueue.push(&transfer)) {
+        transfer.status = SPI_IDLE;
+        SREG = oldSREG;
+        return false;
+    }
+    if (current == nullptr) {
+        powerRequire(POWER_NEED_IO_CLOCK);
+        startNext();
+    }
+    SREG = oldSREG;
+    return true;
+}
+
+bool spiBusy() {
+    return current != nullptr || !pendingQueue.empty();
+}
+
+bool spiTransferBurst(const SpiDevice& device, const uint8_t* tx, uint8_t* rx, uint8_t length) {
+    if (length == 0 || length > SPI_BURST_BYTES || spiBusy()) {
+        return false;
+    }
+
+    // Nothing can start the engine meanwhile: only its own callbacks submit from interrupts.
+    // The chip select is a read-modify-write of a port an ISR may also write (LED matrix)
+    device.apply(false);
+    uint8_t oldSREG = SREG;
+    cli();
+    device.select();
+    SREG = oldSREG;
+    uint8_t out = tx != nullptr ? tx[0] : SPI_FILL_BYTE;
+    for (uint8_t i = 0; i < length; ++i) {
+        SPDR = out;
+        // Next byte fetched while this one shifts out
+        out = (tx != nullptr && i + 1 < length) ? tx[i + 1] : SPI_FILL_BYTE;
+        while (!(SPSR & _BV(SPIF))) {
+        }
+        const uint8_t in = SPDR;
+        if (rx != nullptr) {
+            rx[i] = in;
+        }
+    }
+    oldSREG = SREG;
+    cli();
+    device.deselect();
+    SREG = oldSREG;
+    return true;
+}
+
+#endif // FEATURE_SPI_BUS
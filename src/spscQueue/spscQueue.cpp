@@ -0,0 +1,38 @@
+#include "spscQueue/spscQueue.h"
+
+const QueueBase* QueueBase::headQueue = nullptr;
+
+/**
+ * @brief Constructor of the QueueBase class.
+ *
+ * Queues are global objects, so registration happens during static
+ * initialization, before setup() runs.
+ */
+QueueBase::QueueBase(const char* name, uint8_t elementSize, uint8_t capacity) :
+    head(0),
+    tail(0),
+    overrunCount(0),
+    maxFill(0),
+    queueName(name),
+    elementBytes(elementSize),
+    elementCount(capacity),
+    nextQueue(headQueue)
+    {
+        headQueue = this;
+    }
+
+uint16_t QueueBase::overruns() const {
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint16_t count = overrunCount;
+    SREG = oldSREG;
+    return count;
+}
+
+void QueueBase::resetStats() {
+    uint8_t oldSREG = SREG;
+    cli();
+    overrunCount = 0;
+    maxFill = 0;
+    SREG = oldSREG;
+}
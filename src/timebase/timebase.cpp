@@ -0,0 +1,168 @@
+#include "buildConfig.h"
+
+#if FEATURE_TIMEBASE
+
+#include "timebase/timebase.h"
+#include "spscQueue/spscQueue.h"
+#include "pinout/pinout.h"
+
+volatile uint16_t timebaseOverflows = 0;
+
+static SpscQueue<TimebaseCapture, 16> captures("timebase");
+static bool captureBothEdges = false;
+static bool started = false;
+
+void timebaseBegin() {
+    // The core's init() already runs Timer5 at clk/64 for analogWrite: its
+    // prescaler bits say nothing about whether the timebase owns it
+    if (started) {
+        return;
+    }
+    started = true;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    TCCR5A = 0;              // Normal mode, OC5A-C disconnected
+    TCCR5B = _BV(CS50);      // clk/1
+    TCNT5 = 0;
+    timebaseOverflows = 0;
+    TIFR5 = _BV(TOV5) | _BV(ICF5);
+    TIMSK5 = _BV(TOIE5);
+    SREG = oldSREG;
+}
+
+/**
+ * @brief User of the capture unit.
+ */
+enum CaptureMode : uint8_t {
+    MODE_IDLE,
+    MODE_QUEUE,
+    MODE_RECORD,
+    MODE_CLAIMED
+};
+
+static CaptureMode captureMode = MODE_IDLE;
+static volatile uint16_t* recordBuffer = nullptr;
+static uint8_t recordLength = 0;
+static volatile uint8_t recordCount = 0;
+
+/**
+ * @brief Takes the capture unit and programs its edge. Call with interrupts disabled.
+ */
+static bool acquireCapture(CaptureMode mode, CaptureEdge edge, bool noiseCanceler) {
+    if (captureMode != MODE_IDLE) {
+        return false;
+    }
+    captureMode = mode;
+    pinClaim(TIMEBASE_CAPTURE_PIN);
+
+    uint8_t control = TCCR5B & ~(_BV(ICNC5) | _BV(ICES5));
+    if (noiseCanceler) {
+        control |= _BV(ICNC5);
+    }
+    if (edge != CAPTURE_FALLING) {
+        control |= _BV(ICES5);
+    }
+    TCCR5B = control;
+    captureBothEdges = (edge == CAPTURE_BOTH);
+    TIFR5 = _BV(ICF5);       // Changing ICES5 may latch a spurious capture
+    return true;
+}
+
+bool timebaseCaptureBegin(CaptureEdge edge, bool noiseCanceler) {
+    timebaseBegin();
+
+    uint8_t oldSREG = SREG;
+    cli();
+    const bool acquired = acquireCapture(MODE_QUEUE, edge, noiseCanceler);
+    if (acquired) {
+        pinMode(TIMEBASE_CAPTURE_PIN, INPUT);
+        TIMSK5 |= _BV(ICIE5);
+    }
+    SREG = oldSREG;
+    return acquired;
+}
+
+bool timebaseCaptureRecord(volatile uint16_t* buffer, uint8_t length, CaptureEdge edge, bool noiseCanceler) {
+    if (buffer == nullptr || length == 0) {
+        return false;
+    }
+    timebaseBegin();
+
+    uint8_t oldSREG = SREG;
+    cli();
+    const bool acquired = acquireCapture(MODE_RECORD, edge, noiseCanceler);
+    if (acquired) {
+        recordBuffer = buffer;
+        recordLength = length;
+        recordCount = 0;
+        TIMSK5 |= _BV(ICIE5);
+    }
+    SREG = oldSREG;
+    return acquired;
+}
+
+uint8_t timebaseCaptureCount() {
+    return recordCount;
+}
+
+bool timebaseCaptureClaim(CaptureEdge edge, bool noiseCanceler) {
+    timebaseBegin();
+
+    uint8_t oldSREG = SREG;
+    cli();
+    const bool acquired = acquireCapture(MODE_CLAIMED, edge, noiseCanceler);
+    SREG = oldSREG;
+    return acquired;
+}
+
+void timebaseCaptureEnd() {
+    uint8_t oldSREG = SREG;
+    cli();
+    TIMSK5 &= ~_BV(ICIE5);
+    captureMode = MODE_IDLE;
+    SREG = oldSREG;
+}
+
+bool timebaseCapturePop(TimebaseCapture& capture) {
+    return captures.pop(capture);
+}
+
+ISR(TIMER5_OVF_vect) {
+    timebaseOverflows = timebaseOverflows + 1;
+}
+
+ISR(TIMER5_CAPT_vect) {
+    if (captureMode == MODE_RECORD) {
+        const uint8_t count = recordCount;
+        recordBuffer[count] = ICR5;
+        recordCount = count + 1;
+        if (count + 1 == recordLength) {
+            TIMSK5 &= ~_BV(ICIE5);
+        } else if (captureBothEdges) {
+            TCCR5B ^= _BV(ICES5);
+            TIFR5 = _BV(ICF5);
+        }
+        return;
+    }
+
+    const uint16_t low = ICR5;
+    uint16_t high = timebaseOverflows;
+    // The capture vector has priority over the overflow one: a pending
+    // overflow belongs to this edge only if the latched count already wrapped
+    if ((TIFR5 & _BV(TOV5)) && low < 0x8000) {
+        ++high;
+    }
+
+    TimebaseCapture capture;
+    capture.ticks = ((uint32_t)high << 16) | low;
+    capture.rising = TCCR5B & _BV(ICES5);
+    captures.push(capture);
+
+    if (captureBothEdges) {
+        TCCR5B ^= _BV(ICES5);
+        TIFR5 = _BV(ICF5);
+    }
+}
+
+#endif // FEATURE_TIMEBASE
@@ -0,0 +1,405 @@
+#include "buildConfig.h"
+
+#if FEATURE_TWI
+
+#include "twi/twi.h"
+#include "pinout/pinout.h"
+#include "msg/msg.h"
+#include "scheduler/scheduler.h"
+#include "powerManager/powerManager.h"
+#include "spscQueue/spscQueue.h"
+
+// Status codes of TWSR (prescaler bits masked), master modes
+enum : uint8_t {
+    TW_START = 0x08,
+    TW_REP_START = 0x10,
+    TW_MT_SLA_ACK = 0x18,
+    TW_MT_SLA_NACK = 0x20,
+    TW_MT_DATA_ACK = 0x28,
+    TW_MT_DATA_NACK = 0x30,
+    TW_ARB_LOST = 0x38,
+    TW_MR_SLA_ACK = 0x40,
+    TW_MR_SLA_NACK = 0x48,
+    TW_MR_DATA_ACK = 0x50,
+    TW_MR_DATA_NACK = 0x58,
+    TW_BUS_ERROR = 0x00
+};
+
+// Submitted by tasks, taken by the ISR
+static SpscQueue<TwiTransaction*, TWI_QUEUE_LENGTH> pendingQueue("twi");
+// Finished by the ISR, handed to the callbacks by the service task
+static SpscQueue<TwiTransaction*, 2 * TWI_QUEUE_LENGTH> finishedQueue("twiDone");
+
+static TwiTransaction* volatile current = nullptr;
+static uint8_t byteIndex;                // Next byte of the current phase
+static bool readPhase;                   // After the repeated START
+static volatile uint8_t progress;        // Bumped on every TWI event
+static TwiStats stats;
+
+static bool serviceArmed = false;
+static bool clockHeld = false;           // POWER_NEED_IO_CLOCK held for the bus
+static uint8_t seenProgress;
+static uint16_t stalledSince;
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Bus control (called with interrupts disabled)
+
+static inline void twiControl(uint8_t bits) {
+    TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT) | bits;
+}
+
+/**
+ * @brief Starts the next queued transaction, or leaves the bus idle.
+ *
+ * @param stop  Sends a STOP first (the hardware follows it with the START).
+ */
+static void startNext(bool stop) {
+    TwiTransaction* next;
+    progress = progress + 1;
+    if (pendingQueue.pop(next)) {
+        current = next;
+        next->status = TWI_BUSY;
+        byteIndex = 0;
+        readPhase = false;
+        twiControl(_BV(TWSTA) | (stop ? _BV(TWSTO) : 0));
+        return;
+    }
+
+    // The clock is released by the service task once the STOP is out
+    current = nullptr;
+    if (stop) {
+        twiControl(_BV(TWSTO));
+    }
+}
+
+/**
+ * @brief Ends the current transaction with `status` and moves on.
+ */
+static void finish(TwiStatus status, bool stop) {
+    TwiTransaction* transaction = current;
+    transaction->status = status;
+    if (status == TWI_OK) {
+        ++stats.completed;
+    } else if (status == TWI_NACK_ADDRESS || status == TWI_NACK_DATA) {
+        ++stats.nacks;
+    } else {
+        ++stats.busErrors;
+    }
+    finishedQueue.push(transaction);
+    startNext(stop);
+}
+
+ISR(TWI_vect) {
+    TwiTransaction* transaction = current;
+    progress = progress + 1;
+    if (transaction == nullptr) {
+        twiControl(_BV(TWSTO));   // Stray event: release the bus
+        return;
+    }
+
+    switch (TWSR & 0xF8) {
+    case TW_START:
+    case TW_REP_START:
+        if (transaction->writeLength == 0 && transaction->readLength > 0) {
+            readPhase = true;
+        }
+        TWDR = (transaction->address << 1) | (readPhase ? 1 : 0);
+        twiControl(0);
+        break;
+
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+        if (byteIndex < transaction->writeLength) {
+            TWDR = transaction->writeData[byteIndex++];
+            twiControl(0);
+        } else if (transaction->readLength > 0) {
+            readPhase = true;
+            byteIndex = 0;
+            twiControl(_BV(TWSTA));   // Repeated START
+        } else {
+            finish(TWI_OK, true);
+        }
+        break;
+
+    case TW_MR_SLA_ACK:
+        twiControl(transaction->readLength > 1 ? _BV(TWEA) : 0);
+        break;
+
+    case TW_MR_DATA_ACK:
+        transaction->readData[byteIndex++] = TWDR;
+        twiControl(byteIndex + 1 < transaction->readLength ? _BV(TWEA) : 0);
+        break;
+
+    case TW_MR_DATA_NACK:
+        transaction->readData[byteIndex] = TWDR;
+        finish(TWI_OK, true);
+        break;
+
+    case TW_MT_SLA_NACK:
+    case TW_MR_SLA_NACK:
+        finish(TWI_NACK_ADDRESS, true);
+        break;
+
+    case TW_MT_DATA_NACK:
+        finish(TWI_NACK_DATA, true);
+        break;
+
+    case TW_ARB_LOST:
+        finish(TWI_ARBITRATION_LOST, false);   // START again once the bus is free
+        break;
+
+    default:                                   // TW_BUS_ERROR and unexpected codes
+        finish(TWI_BUS_ERROR, true);
+        break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Bus recovery (TWI disabled, pins driven as open drain)
+
+static void lineLow(uint8_t pin) {
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+}
+
+static void lineRelease(uint8_t pin) {
+    pinMode(pin, INPUT_PULLUP);
+}
+
+/**
+ * @brief Clocks SCL (up to 9 pulses) until the slave releases SDA, then sends a STOP.
+ */
+static void recoverBus() {
+    const uint8_t sda = Pins::I2C[0].number;
+    const uint8_t scl = Pins::I2C[1].number;
+
+    TWCR = 0;
+    lineRelease(sda);
+    lineRelease(scl);
+    for (uint8_t pulse = 0; pulse < 9 && digitalRead(sda) == LOW; ++pulse) {
+        lineLow(scl);
+        delayMicroseconds(5);
+        lineRelease(scl);
+        delayMicroseconds(5);
+    }
+
+    // STOP: SDA rises while SCL is high
+    lineLow(sda);
+    delayMicroseconds(5);
+    lineRelease(scl);
+    delayMicroseconds(5);
+    lineRelease(sda);
+    delayMicroseconds(5);
+
+    TWCR = _BV(TWEN) | _BV(TWIE);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Service task
+
+static void twiService();
+
+static void armService() {
+    if (!serviceArmed && schedulerAddOneShot(twiService, 1, TASK_PRIORITY_NORMAL) != INVALID_TASK) {
+        serviceArmed = true;
+    }
+}
+
+/**
+ * @brief Fails a transaction that stopped progressing and recovers the bus.
+ */
+static void checkTimeout() {
+    if (current == nullptr) {
+        return;
+    }
+
+    const uint8_t seen = progress;
+    const uint16_t now = (uint16_t)schedulerMillis();
+    if (seen != seenProgress) {
+        seenProgress = seen;
+        stalledSince = now;
+        return;
+    }
+    if ((uint16_t)(now - stalledSince) < TWI_TIMEOUT_MS) {
+        return;
+    }
+
+    // The ISR may have moved on since the check above: only a transaction
+    // still stalled is killed
+    uint8_t oldSREG = SREG;
+    cli();
+    TwiTransaction* hung = current;
+    if (hung == nullptr || progress != seenProgress) {
+        SREG = oldSREG;
+        return;
+    }
+    TWCR = 0;                  // No more TWI interrupts during the recovery
+    SREG = oldSREG;
+
+    recoverBus();
+
+    oldSREG = SREG;
+    cli();
+    hung->status = TWI_TIMEOUT;
+    ++stats.timeouts;
+    finishedQueue.push(hung);
+    startNext(false);
+    SREG = oldSREG;
+}
+
+/**
+ * @brief Releases the I/O clock once the bus is idle and the last STOP has been sent.
+ */
+static void releaseClockWhenIdle() {
+    uint8_t oldSREG = SREG;
+    cli();
+    if (clockHeld && current == nullptr && !(TWCR & _BV(TWSTO))) {
+        clockHeld = false;
+        powerRelease(POWER_NEED_IO_CLOCK);
+    }
+    SREG = oldSREG;
+}
+
+/**
+ * @brief Calls the completion callbacks and watches for bus hangs while busy.
+ */
+static void twiService() {
+    serviceArmed = false;
+
+    TwiTransaction* transaction;
+    while (finishedQueue.pop(transaction)) {
+        if (transaction->done != nullptr) {
+            transaction->done(*transaction);
+        }
+    }
+
+    checkTimeout();
+    releaseClockWhenIdle();
+
+    if (twiBusy() || !finishedQueue.empty() || clockHeld) {
+        armService();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// API
+
+void twiBegin() {
+    // Internal pull-ups; 400 kHz needs external ones (~2.2 kΩ)
+    pinMode(Pins::I2C[0].number, INPUT_PULLUP);
+    pinMode(Pins::I2C[1].number, INPUT_PULLUP);
+    pinClaim(Pins::I2C[0].number);
+    pinClaim(Pins::I2C[1].number);
+    twiSetFrequency(TWI_DEFAULT_HZ);
+
+    if (digitalRead(Pins::I2C[0].number) == LOW) {
+        recoverBus();                           // A slave reset mid-byte still holds SDA
+    } else {
+        TWCR = _BV(TWEN) | _BV(TWIE);
+    }
+}
+
+void twiSetFrequency(uint32_t hz) {
+    if (hz > 400000UL || hz < 31000UL) {
+        standardErrorMessage("Frecuencia I2C fuera de rango", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return;
+    }
+    TWSR = 0;                                   // Prescaler 1
+    TWBR = (uint8_t)((F_CPU / hz - 16) / 2);
+}
+
+bool twiSubmit(TwiTransaction& transaction) {
+    if (!twiFinished(transaction)) {
+        return false;
+    }
+    if ((transaction.writeLength > 0 && transaction.writeData == nullptr)
+        || (transaction.readLength > 0 && transaction.readData == nullptr)
+        || transaction.address > 0x7F) {
+        standardErrorMessage("Transacción I2C no válida", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return false;
+    }
+    if (!(TWCR & _BV(TWEN))) {
+        twiBegin();
+    }
+
+    transaction.status = TWI_QUEUED;
+    if (!pendingQueue.push(&transaction)) {
+        transaction.status = TWI_IDLE;
+        return false;
+    }
+
+    uint8_t oldSREG = SREG;
+    cli();
+    if (current == nullptr) {
+        // A STOP still being sent must end before the next START
+        while (TWCR & _BV(TWSTO)) {
+        }
+        if (!clockHeld) {
+            clockHeld = true;
+            powerRequire(POWER_NEED_IO_CLOCK);
+        }
+        startNext(false);
+    }
+    SREG = oldSREG;
+
+    armService();
+    return true;
+}
+
+bool twiBusy() {
+    return current != nullptr || !pendingQueue.empty();
+}
+
+TwiStats twiStats() {
+    uint8_t oldSREG = SREG;
+    cli();
+    const TwiStats copy = stats;
+    SREG = oldSREG;
+    return copy;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Shell
+
+static TwiTransaction probe;
+static uint8_t scanAddress;
+static uint8_t scanFound[16];
+static bool scanning = false;
+
+bool twiCommand(const char* args) {
+    if (*args == '\0') {
+        showTwiReport(twiStats());
+        return true;
+    }
+    if (strcmp(args, "scan") != 0) {
+        standardErrorMessage("Uso: twi [scan]", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        return true;
+    }
+
+    if (!scanning) {
+        memset(scanFound, 0, sizeof(scanFound));
+        scanAddress = 0x08;                    // 0x00-0x07 and 0x78-0x7F are reserved
+        probe.status = TWI_IDLE;
+        scanning = true;
+    }
+    if (!twiFinished(probe)) {
+        return false;
+    }
+    if (probe.status == TWI_OK) {
+        scanFound[probe.address >> 3] |= _BV(probe.address & 0x07);
+    }
+    probe.status = TWI_IDLE;
+
+    if (scanAddress > 0x77) {
+        scanning = false;
+        showTwiScan(scanFound);
+        return true;
+    }
+    probe.address = scanAddress;
+    if (twiSubmit(probe)) {
+        ++scanAddress;
+    }
+    return false;
+}
+
+#endif // FEATURE_TWI
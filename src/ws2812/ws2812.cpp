@@ -0,0 +1,238 @@
+#include "buildConfig.h"
+
+#if FEATURE_WS2812
+
+#include "ws2812/ws2812.h"
+#include "pinout/pinout.h"
+#include "msg/msg.h"
+
+#if F_CPU != 16000000UL
+#error "The WS2812 send loop is timed for 16 MHz"
+#endif
+
+// Minimum low time between frames so the LEDs latch the data (WS2812B-V5: 280 µs)
+static constexpr uint16_t WS2812_LATCH_MICROS = 300;
+
+/**
+ * @brief Clocks `bytesPerLane` bytes out on every lane of one I/O port.
+ *
+ * Bit timing at 16 MHz (cycles from the rising edge):
+ *   t = 0   all lanes HIGH
+ *   t = 6   lanes sending a 0 go LOW          (T0H = 375 ns)
+ *   t = 13  every lane LOW                    (T1H = 812 ns)
+ *   t = 20  next bit                          (1.25 µs per bit)
+ *
+ * While one bit is on the wire, the mask of the next bit is built from the
+ * top bit of each lane byte. Between bytes the line stays LOW for about one
+ * extra microsecond while the next byte of each lane is loaded, which is well
+ * inside the low-time tolerance of the WS2812.
+ *
+ * @tparam IO_ADDR  I/O address of the PORTx register (for the `out` instruction).
+ */
+template <uint8_t IO_ADDR>
+static void ws2812SendPort(const uint8_t* data, uint16_t bytesPerLane, uint8_t lanes,
+                           const uint8_t* mask, uint8_t hi, uint8_t lo) {
+    uint8_t d0 = 0, d1 = 0, d2 = 0, d3 = 0;
+    uint8_t cur, nxt, bitCount;
+
+    asm volatile(
+        "rjmp 3f                  \n\t"   // Load the first byte of every lane
+    "1:                           \n\t"   // ---- bit loop, t = 0
+        "out  %[port], %[hi]      \n\t"   // 1  all lanes HIGH
+        "lsl  %[d0]               \n\t"   // 1  next bit of each lane to bit 7
+        "lsl  %[d1]               \n\t"   // 1
+        "lsl  %[d2]               \n\t"   // 1
+        "lsl  %[d3]               \n\t"   // 1
+        "mov  %[nxt], %[lo]       \n\t"   // 1
+        "out  %[port], %[cur]     \n\t"   // 1  t = 6: lanes sending 0 go LOW
+        "sbrc %[d0], 7            \n\t"   // 2
+        "or   %[nxt], %[m0]       \n\t"
+        "sbrc %[d1], 7            \n\t"   // 2
+        "or   %[nxt], %[m1]       \n\t"
+        "sbrc %[d2], 7            \n\t"   // 2
+        "or   %[nxt], %[m2]       \n\t"
+        "out  %[port], %[lo]      \n\t"   // 1  t = 13: every lane LOW
+        "sbrc %[d3], 7            \n\t"   // 2
+        "or   %[nxt], %[m3]       \n\t"
+        "mov  %[cur], %[nxt]      \n\t"   // 1
+        "dec  %[bits]             \n\t"   // 1
+        "brne 1b                  \n\t"   // 2  t = 20
+        "sbiw %[count], 1         \n\t"   // ---- byte boundary (lines LOW)
+        "breq 4f                  \n\t"
+    "3:                           \n\t"
+        "ld   %[d0], Z+           \n\t"
+        "cpi  %[lanes], 2         \n\t"
+        "brlo 2f                  \n\t"
+        "ld   %[d1], Z+           \n\t"
+        "cpi  %[lanes], 3         \n\t"
+        "brlo 2f                  \n\t"
+        "ld   %[d2], Z+           \n\t"
+        "cpi  %[lanes], 4         \n\t"
+        "brlo 2f                  \n\t"
+        "ld   %[d3], Z+           \n\t"
+    "2:                           \n\t"
+        "mov  %[cur], %[lo]       \n\t"   // Mask of bit 7 of the new bytes
+        "sbrc %[d0], 7            \n\t"
+        "or   %[cur], %[m0]       \n\t"
+        "sbrc %[d1], 7            \n\t"
+        "or   %[cur], %[m1]       \n\t"
+        "sbrc %[d2], 7            \n\t"
+        "or   %[cur], %[m2]       \n\t"
+        "sbrc %[d3], 7            \n\t"
+        "or   %[cur], %[m3]       \n\t"
+        "ldi  %[bits], 8          \n\t"
+        "rjmp 1b                  \n\t"
+    "4:                           \n\t"
+        : [d0] "+r" (d0), [d1] "+r" (d1), [d2] "+r" (d2), [d3] "+r" (d3),
+          [cur] "=&r" (cur), [nxt] "=&r" (nxt), [bits] "=&d" (bitCount),
+          [count] "+w" (bytesPerLane), [ptr] "+z" (data)
+        : [port] "I" (IO_ADDR), [hi] "r" (hi), [lo] "r" (lo), [lanes] "d" (lanes),
+          [m0] "r" (mask[0]), [m1] "r" (mask[1]), [m2] "r" (mask[2]), [m3] "r" (mask[3])
+        : "memory"
+    );
+}
+
+/**
+ * @brief Cycles used by `ws2812SendPort()` for one byte of every lane.
+ *
+ * 7 full bits, the last bit up to the fall-through of `brne`, `sbiw`/`breq`,
+ * the loads (which depend on the number of lanes) and the mask of the next bit.
+ */
+static uint16_t ws2812CyclesPerByte(uint8_t lanes) {
+    static const uint8_t loadCycles[Ws2812::MAX_LANES] = {5, 9, 13, 14};
+    return 7 * 20 + 19 + 3 + loadCycles[lanes - 1] + 12;
+}
+
+/**
+ * @brief Constructor of the Ws2812 class.
+ *
+ * Resolves the data pins into the shared port register and the bit of each lane.
+ */
+Ws2812::Ws2812(uint8_t* buf, uint16_t leds, const uint8_t* lanePins, uint8_t lanes) :
+    buffer(buf),
+    numLeds(leds),
+    numLanes(lanes),
+    portMask(0),
+    port(nullptr),
+    valid(false),
+    lastShowMicros(0),
+    irqOffMicros(0),
+    irqOffMaxMicros(0)
+    {
+        memset(laneMask, 0, sizeof(laneMask));
+
+        if (buf == nullptr || leds == 0 || lanes == 0 || lanes > MAX_LANES) {
+            standardErrorMessage("Configuracion de tira WS2812 no soportada", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+            return;
+        }
+
+        for (uint8_t i = 0; i < lanes; ++i) {
+            if (isPinInGPIO(lanePins[i]) == false) {
+                standardErrorMessage("El pin no existe en la configuración de PinGIO", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+                return;
+            }
+
+            volatile uint8_t* lanePort = portOutputRegister(digitalPinToPort(lanePins[i]));
+            if (port != nullptr && lanePort != port) {
+                standardErrorMessage("Las tiras WS2812 deben compartir puerto", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+                return;
+            }
+
+            port = lanePort;
+            pins[i] = lanePins[i];
+            laneMask[i] = digitalPinToBitMask(lanePins[i]);
+            portMask |= laneMask[i];
+        }
+
+        valid = true;
+    }
+
+bool Ws2812::begin() {
+    if (!valid) {
+        return false;
+    }
+
+    if (port != &PORTA && port != &PORTB && port != &PORTC && port != &PORTD &&
+        port != &PORTE && port != &PORTF && port != &PORTG) {
+        standardErrorMessage("Puerto sin acceso 'out' para WS2812", __FILE__, __FUNCTION__, __DATE__, __TIME__, __LINE__);
+        valid = false;
+        return false;
+    }
+
+    for (uint8_t i = 0; i < numLanes; ++i) {
+        pinMode(pins[i], OUTPUT);
+        digitalWrite(pins[i], LOW);
+    }
+
+    clear();
+    lastShowMicros = micros();
+    return true;
+}
+
+void Ws2812::setPixel(uint8_t lane, uint16_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (lane >= numLanes || index >= numLeds) {
+        return;
+    }
+    uint8_t* p = buffer + (size_t)index * 3 * numLanes + lane;
+    p[0]            = green;
+    p[numLanes]     = red;
+    p[2 * numLanes] = blue;
+}
+
+void Ws2812::clear() {
+    if (buffer != nullptr) {
+        memset(buffer, 0, bufferSize(numLeds, numLanes));
+    }
+}
+
+/**
+ * @brief Sends the frame with interrupts disabled and records how long they were off.
+ *
+ * The send loop is cycle exact, so the interrupt-off time is taken from its cycle
+ * count: Timer0 cannot time a window that may last several of its overflows.
+ */
+void Ws2812::show() {
+    if (!valid) {
+        return;
+    }
+
+    while (micros() - lastShowMicros < WS2812_LATCH_MICROS) {
+        // Latch of the previous frame
+    }
+
+    const uint16_t bytesPerLane = numLeds * 3;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint8_t lo = *port & ~portMask;
+    const uint8_t hi = lo | portMask;
+
+    // I/O addresses of PORTA..PORTG (ATmega2560 register summary)
+    if (port == &PORTA) {
+        ws2812SendPort<0x02>(buffer, bytesPerLane, numLanes, laneMask, hi, lo);
+    } else if (port == &PORTB) {
+        ws2812SendPort<0x05>(buffer, bytesPerLane, numLanes, laneMask, hi, lo);
+    } else if (port == &PORTC) {
+        ws2812SendPort<0x08>(buffer, bytesPerLane, numLanes, laneMask, hi, lo);
+    } else if (port == &PORTD) {
+        ws2812SendPort<0x0B>(buffer, bytesPerLane, numLanes, laneMask, hi, lo);
+    } else if (port == &PORTE) {
+        ws2812SendPort<0x0E>(buffer, bytesPerLane, numLanes, laneMask, hi, lo);
+    } else if (port == &PORTF) {
+        ws2812SendPort<0x11>(buffer, bytesPerLane, numLanes, laneMask, hi, lo);
+    } else {
+        ws2812SendPort<0x14>(buffer, bytesPerLane, numLanes, laneMask, hi, lo);
+    }
+    SREG = oldSREG;
+
+    const uint32_t cycles = (uint32_t)bytesPerLane * ws2812CyclesPerByte(numLanes);
+    const uint32_t offMicros = cycles / (F_CPU / 1000000UL);
+    irqOffMicros = offMicros > 0xFFFF ? 0xFFFF : (uint16_t)offMicros;
+    if (irqOffMicros > irqOffMaxMicros) {
+        irqOffMaxMicros = irqOffMicros;
+    }
+
+    lastShowMicros = micros();
+}
+
+#endif // FEATURE_WS2812
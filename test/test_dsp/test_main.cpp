@@ -0,0 +1,101 @@
+/*
+ * Host tests of the header-only DSP code: pio test -e native
+ *
+ * Both checks are exhaustive, so they run on the host instead of the board.
+ */
+
+#include <stdio.h>
+#include <unity.h>
+#include "dsp/filters.h"
+#include "dsp/fixed.h"
+
+void setUp() {}
+void tearDown() {}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// FixedRatio: every 16-bit input against the exact quotient
+
+template <uint32_t NUM, uint32_t DEN>
+static void sweepRatio() {
+    for (uint32_t x = 0; x <= 0xFFFF; ++x) {
+        uint64_t exact = (uint64_t)x * NUM / DEN;
+        if (exact > 0xFFFF) {
+            exact = 0xFFFF;
+        }
+        const uint16_t scaled = fixedScale<FixedRatio<NUM, DEN>>((uint16_t)x);
+        if (scaled != exact) {
+            char message[64];
+            snprintf(message, sizeof(message), "%lu * %lu / %lu", (unsigned long)x, (unsigned long)NUM, (unsigned long)DEN);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(exact, scaled, message);
+        }
+    }
+}
+
+static void test_fixed_ratio_common_scales() {
+    sweepRatio<1, 10>();
+    sweepRatio<1, 100>();
+    sweepRatio<1, 1000>();
+    sweepRatio<1, 60>();
+    sweepRatio<5000, 1023>();
+    sweepRatio<1100, 1023>();
+    sweepRatio<2560, 1023>();
+    sweepRatio<9, 5>();
+}
+
+static void test_fixed_ratio_awkward_scales() {
+    sweepRatio<1, 3>();
+    sweepRatio<1, 7>();
+    sweepRatio<2, 3>();
+    sweepRatio<1, 65535>();
+    sweepRatio<65534, 65535>();
+    sweepRatio<1000, 3>();
+    sweepRatio<7, 1>();
+}
+
+static void test_fixed_ratio_exact_multiples() {
+    TEST_ASSERT_EQUAL_UINT16(1, fixedScale<RatioDiv100>(100));
+    TEST_ASSERT_EQUAL_UINT16(1, fixedScale<RatioDiv1000>(1000));
+    TEST_ASSERT_EQUAL_UINT16(9, fixedScale<RatioCelsiusToFahrenheit>(5));
+    TEST_ASSERT_EQUAL_UINT16(2560, fixedScale<RatioAdcToMillivolts2V56>(1023));
+}
+
+static void test_fixed_scaled_matches_scale() {
+    typedef Fixed<15, 0> Whole;
+    for (int32_t x = 0; x <= Whole::RAW_MAX; ++x) {
+        TEST_ASSERT_EQUAL_INT16(fixedScale<RatioDiv10>((uint16_t)x), Whole::fromRaw((int16_t)x).scaled<RatioDiv10>().raw());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------------
+// MedianNetwork: 0-1 principle, every binary input leaves the median in the middle
+
+template <uint8_t N>
+static void zeroOneMedian() {
+    for (uint16_t bits = 0; bits < (1u << N); ++bits) {
+        uint8_t p[N];
+        uint8_t ones = 0;
+        for (uint8_t i = 0; i < N; ++i) {
+            p[i] = (bits >> i) & 1;
+            ones += p[i];
+        }
+        const uint8_t median = ones > N / 2 ? 1 : 0;
+        TEST_ASSERT_EQUAL_UINT8(median, MedianNetwork<N>::select(p));
+    }
+}
+
+static void test_median_network_zero_one() {
+    zeroOneMedian<3>();
+    zeroOneMedian<5>();
+    zeroOneMedian<7>();
+    zeroOneMedian<9>();
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed_ratio_common_scales);
+    RUN_TEST(test_fixed_ratio_awkward_scales);
+    RUN_TEST(test_fixed_ratio_exact_multiples);
+    RUN_TEST(test_fixed_scaled_matches_scale);
+    RUN_TEST(test_median_network_zero_one);
+    return UNITY_END();
+}